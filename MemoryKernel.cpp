@@ -1,13 +1,17 @@
 #include "MemoryKernel.hpp"
 
-#include <fstream>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
-#include <regex>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "ast.hpp"
+#include "diagnostics.hpp"
+#include "numbers.hpp"
 
 /**************************************************
  *           Local Functions Prototypes
@@ -20,89 +24,239 @@
  * Warning: `is_array_element` should be called first
  *
  * @param name Name of element to be extracted
- * @return extracted name of array
+ * @return extracted name of array (view into `name`)
  */
-static std::string extract_array_name(std::string name);
+static std::string_view extract_array_name(std::string_view name);
+
+/**
+ * @brief Check if number is whole and fits long long
+ *        (negative zero is not whole, integer has no sign of zero)
+ *
+ * @param number Number to check
+ * @param out Receives integer if number is whole
+ */
+static bool whole_number(double number, long long &out);
+
+/**
+ * @brief Get position named by index key ("0", "1", ...)
+ *
+ * @param key Key to check
+ * @param out Receives position if key is index
+ * @return false if key is not a canonical non-negative integer
+ */
+static bool index_of(Symbol key, size_t &out);
 
 /**************************************************
  *           MemObject Implementation
  **************************************************/
 
-MemObject::MemObject(ObjectType type, std::string name, std::string value)
-    : type(type), name(name), value(value), num_references(0), writable(true) {};
-
-MemObject::~MemObject() {
-  static std::fstream out;
+MemObject::MemObject(ObjectType type, Symbol name, std::string value)
+    : type(type),
+      name(name),
+      value(std::move(value)),
+      num_references(0),
+      writable(true),
+      number(0),
+      number_ready(false),
+      integer(0),
+      integral(false) {};
+
+MemObject::MemObject(ObjectType type, std::string_view name, std::string value)
+    : MemObject(type, intern(name), std::move(value)) {};
+
+MemObject::MemObject(Symbol name, double number)
+    : MemObject(OBJECT_NUMBER, name, NumberFormat::format(number)) {
+  // rounded text is parsed when needed, as number is what text says
+  long long whole = 0;
+  bool is_whole = whole_number(number, whole);
+  if (is_whole || NumberFormat::exact()) cache_number(number, is_whole, whole);
+}
 
-  if (!out.is_open()) out.open(".nnl_warn", std::ios_base::out);
+MemObject::MemObject(Symbol name, long long integer)
+    : MemObject(OBJECT_NUMBER, name, NumberFormat::format_integer(integer)) {
+  cache_number(integer, true, integer);
+}
 
-  if (!count_references()) {
-    out << "Warning: variable " << this->get_name()
-        << " was not used anywhere. You can remove it.\n";
-    out.flush();
-  }
+MemObject::~MemObject() {
+  // with diagnostics off destructor does nothing
+  if (Diagnostics::enabled() && !count_references())
+    Diagnostics::unused_object(this->name);
 }
 
 ObjectType MemObject::get_type() const { return this->type; }
 
-std::string MemObject::get_name() const { return this->name; }
+Symbol MemObject::get_symbol() const { return this->name; }
 
-std::string MemObject::get_value() const { return this->value; }
+const std::string &MemObject::get_name() const {
+  return symbol_name(this->name);
+}
+
+const std::string &MemObject::get_value() const { return this->value; }
 
 unsigned int MemObject::count_references() const {
   return this->num_references;
 }
 
+void MemObject::cache_number(double number, bool whole,
+                             long long integer) const {
+  this->number.store(number, std::memory_order_relaxed);
+  this->integer.store(integer, std::memory_order_relaxed);
+  this->integral.store(whole, std::memory_order_relaxed);
+  this->number_ready.store(true, std::memory_order_release);
+}
+
+void MemObject::parse_number() const {
+  // integers are read exactly, without floating point
+  long long whole;
+  if (NumberFormat::parse_integer(this->value, whole)) {
+    cache_number(whole, true, whole);
+    return;
+  }
+
+  double parsed = NumberFormat::parse(this->value);
+  whole = 0;
+  cache_number(parsed, whole_number(parsed, whole), whole);
+}
+
+double MemObject::get_number() const {
+  if (!this->number_ready.load(std::memory_order_acquire)) parse_number();
+  return this->number.load(std::memory_order_relaxed);
+}
+
+bool MemObject::get_integer(long long &out) const {
+  if (!this->number_ready.load(std::memory_order_acquire)) parse_number();
+  out = this->integer.load(std::memory_order_relaxed);
+  return this->integral.load(std::memory_order_relaxed);
+}
+
+void MemObject::copy_number(const MemObject &from) {
+  bool ready = from.number_ready.load(std::memory_order_acquire);
+  if (ready) {
+    this->number.store(from.number.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    this->integer.store(from.integer.load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+    this->integral.store(from.integral.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+  }
+  this->number_ready.store(ready, std::memory_order_relaxed);
+}
+
 bool MemObject::is_writable() const { return this->writable; }
 
 void MemObject::set_type(ObjectType type) { this->type = type; }
 
-void MemObject::set_value(std::string value) { this->value = value; }
+void MemObject::set_value(std::string value) {
+  this->value = std::move(value);
+  this->number_ready.store(false, std::memory_order_relaxed);
+}
+
+void MemObject::set_text(std::string_view text) {
+  this->value.assign(text.data(), text.size());
+  this->number_ready.store(false, std::memory_order_relaxed);
+}
+
+void MemObject::set_number(double number) {
+  this->value = NumberFormat::format(number);
+  long long whole = 0;
+  bool is_whole = whole_number(number, whole);
+  if (is_whole || NumberFormat::exact())
+    cache_number(number, is_whole, whole);
+  else
+    this->number_ready.store(false, std::memory_order_relaxed);
+}
+
+void MemObject::set_integer(long long integer) {
+  this->value = NumberFormat::format_integer(integer);
+  cache_number(integer, true, integer);
+}
 
 void MemObject::make_const() {this->writable = false;}
 
+void MemObject::assign(const MemObject &other) {
+  this->type = other.type;
+  this->value.assign(other.value);
+  this->copy_number(other);
+}
+
+void MemObject::append_value(const std::string &text) {
+  this->value += text;
+  this->number_ready.store(false, std::memory_order_relaxed);
+}
+
 void MemObject::ref_inc() { this->num_references++; }
 
+MemObject *MemObject::copy_as(Symbol name) const {
+  MemObject *copy = new MemObject(this->type, name, this->value);
+  copy->copy_number(*this);
+  return copy;
+}
+
+/**************************************************
+ *          ConstantPool Implementation
+ **************************************************/
+
+MemObject *ConstantPool::get(ObjectType type, const std::string &value) {
+  static ConstantPool pool;
+
+  MemObject *&obj = pool.objects[{type, value}];
+  if (!obj) {
+    obj = new MemObject(type, 0, value);
+    obj->make_const();
+    if (type == OBJECT_NUMBER) obj->get_number();
+  }
+  return obj;
+}
+
 /**************************************************
  *          MemFunction Implementation
  **************************************************/
 
-MemFunction::MemFunction(std::string name, void *entry_point,
-                         std::vector<std::string> arg_names)
+MemFunction::MemFunction(Symbol name, void *entry_point,
+                         std::vector<Symbol> arg_names)
     : MemObject(OBJECT_FUNC, name, "(func)"),
       entry_point(entry_point),
       arg_names(arg_names) {}
 
+MemFunction::MemFunction(std::string name, void *entry_point,
+                         std::vector<std::string> arg_names)
+    : MemObject(OBJECT_FUNC, name, "(func)"), entry_point(entry_point) {
+  for (auto &arg : arg_names) this->arg_names.push_back(intern(arg));
+}
+
 void *MemFunction::get_entry_point() const { return this->entry_point; }
 
-std::vector<std::string> MemFunction::get_arg_names() const {
-  return std::vector<std::string>(this->arg_names);
+const std::vector<Symbol> &MemFunction::get_arg_names() const {
+  return this->arg_names;
 }
 
 unsigned int MemFunction::count_args() { return this->arg_names.size(); }
 
+MemObject *MemFunction::copy_as(Symbol name) const {
+  return new MemFunction(name, this->entry_point, this->arg_names);
+}
+
 bool MemFunction::prep_mem(MemoryKernel &mem, std::vector<MemObject *> args) {
   /**
    * There might array elements be
    * passed, and all array element should be considered
    * as single parameter
    */
-  std::set<std::string> all_elements;
-  std::set<std::string> vars;
-  std::set<std::string> args_set(this->arg_names.begin(),
-                                 this->arg_names.end());
+  std::set<Symbol> all_elements;
+  std::set<Symbol> vars;
+  std::set<Symbol> args_set(this->arg_names.begin(), this->arg_names.end());
 
-  std::set<std::string> arr_appeared;
+  std::set<Symbol> arr_appeared;
 
   for (auto &arg : args) {
-    std::string name = arg->get_name();
+    Symbol name = arg->get_symbol();
 
     // return error if same element appeared multiple times
     if (all_elements.find(name) != all_elements.end()) return false;
     all_elements.insert(name);
 
-    if (MemoryKernel::is_array_element(arg->get_name())) {
-      name = extract_array_name(arg->get_name());
+    if (SymbolTable::global().is_array_element(name)) {
+      name = intern(extract_array_name(arg->get_name()));
       arr_appeared.insert(name);
     }
 
@@ -125,20 +279,471 @@ bool MemFunction::prep_mem(MemoryKernel &mem, std::vector<MemObject *> args) {
    */
 
   // after all checks are passed, just push args to current scope
-  for (MemObject *obj : args) mem.scopes[mem.scopes.size() - 1].push_back(obj);
+  // (separately passed array elements are collected into arrays)
+  auto &scope = mem.scopes[mem.scopes.size() - 1];
+  std::unordered_map<Symbol, MemArray *> collected;
+  for (MemObject *obj : args) {
+    if (!SymbolTable::global().is_array_element(obj->get_symbol())) {
+      MemoryKernel::track_binding(obj);
+      scope.push_back(obj);
+      continue;
+    }
+
+    Symbol name, key;
+    MemoryKernel::split_element(obj->get_name(), name, key, true);
+    MemArray *&arr = collected[name];
+    if (!arr) {
+      arr = new MemArray(name, std::make_shared<ArrayData>());
+      scope.push_back(arr);
+    }
+    arr->mutable_elements().set(key, obj);
+  }
 
   return true;
 }
 
+/**************************************************
+ *             Shape Implementation
+ **************************************************/
+
+Shape::Shape(bool shared) : shared(shared), implicit(0) {}
+
+Shape::Shape(const Shape &other, bool shared)
+    : keys(other.keys),
+      index(other.index),
+      shared(shared),
+      implicit(other.implicit) {}
+
+std::shared_ptr<Shape> Shape::indices(size_t count) {
+  std::shared_ptr<Shape> shape = std::make_shared<Shape>(false);
+  shape->implicit = count;
+  return shape;
+}
+
+void Shape::spell_out() {
+  this->keys.reserve(this->implicit);
+  for (size_t i = 0; i < this->implicit; ++i) {
+    this->keys.push_back(index_symbol(i));
+    this->index[this->keys.back()] = i;
+  }
+  this->implicit = 0;
+}
+
+bool Shape::is_shared() const { return this->shared; }
+
+size_t Shape::size() const { return this->implicit + this->keys.size(); }
+
+Symbol Shape::key_at(size_t pos) const {
+  if (this->implicit) return index_symbol(pos);
+  return this->keys[pos];
+}
+
+bool Shape::implicit_keys() const { return this->keys.empty(); }
+
+long Shape::offset(Symbol key) const {
+  if (this->implicit) {
+    size_t pos;
+    if (!index_of(key, pos) || pos >= this->implicit) return -1;
+    return pos;
+  }
+
+  auto it = this->index.find(key);
+  if (it == this->index.end()) return -1;
+  return it->second;
+}
+
+void Shape::append(Symbol key) {
+  size_t pos;
+  if (this->keys.empty() && index_of(key, pos) && pos == this->implicit) {
+    ++this->implicit;
+    return;
+  }
+  if (this->implicit) spell_out();
+
+  this->index[key] = this->keys.size();
+  this->keys.push_back(key);
+}
+
+void Shape::erase(Symbol key) {
+  size_t pos;
+  if (this->implicit && index_of(key, pos) && pos + 1 == this->implicit) {
+    --this->implicit;
+    return;
+  }
+  if (this->implicit) spell_out();
+
+  auto it = this->index.find(key);
+  if (it == this->index.end()) return;
+
+  pos = it->second;
+  this->keys.erase(this->keys.begin() + pos);
+  this->index.erase(it);
+  for (auto &entry : this->index)
+    if (entry.second > pos) --entry.second;
+}
+
+std::shared_ptr<Shape> Shape::add(std::shared_ptr<Shape> &self, Symbol key) {
+  if (self->shared && self->size() < MAX_SHARED_KEYS) {
+    // shared shapes are used by all threads
+    static std::mutex transitions_lock;
+    std::lock_guard<std::mutex> guard(transitions_lock);
+
+    std::shared_ptr<Shape> &next = self->transitions[key];
+    if (!next) {
+      next = std::make_shared<Shape>(*self, true);
+      next->append(key);
+    }
+    return next;
+  }
+
+  // private shape which is not used by other storage
+  // can be extended in place (no copy of keys)
+  if (!self->shared && self.use_count() == 1) {
+    self->append(key);
+    return self;
+  }
+
+  std::shared_ptr<Shape> next = std::make_shared<Shape>(*self, false);
+  next->append(key);
+  return next;
+}
+
+/**************************************************
+ *           ArrayData Implementation
+ **************************************************/
+
+ArrayData::ArrayData()
+    : layout(std::make_shared<Shape>(false)),
+      typed(false),
+      borrowed(nullptr),
+      borrowed_size(0),
+      materialized(true) {}
+
+ArrayData::ArrayData(std::shared_ptr<Shape> shape,
+                     std::vector<MemObject *> values)
+    : layout(shape),
+      values(values),
+      typed(false),
+      borrowed(nullptr),
+      borrowed_size(0),
+      materialized(true) {}
+
+ArrayData::ArrayData(std::shared_ptr<Shape> shape, std::vector<double> numbers)
+    : layout(shape),
+      numbers(std::move(numbers)),
+      typed(true),
+      borrowed(nullptr),
+      borrowed_size(0),
+      materialized(this->numbers.empty()) {}
+
+ArrayData::ArrayData(std::shared_ptr<Shape> shape,
+                     std::shared_ptr<const void> source, const double *numbers,
+                     size_t count)
+    : layout(shape),
+      typed(true),
+      source(count ? source : nullptr),
+      borrowed(count ? numbers : nullptr),
+      borrowed_size(count),
+      materialized(count == 0) {}
+
+ArrayData::ArrayData(const ArrayData &other)
+    : layout(other.layout),
+      numbers(other.numbers),
+      typed(other.typed),
+      source(other.source),
+      borrowed(other.borrowed),
+      borrowed_size(other.borrowed_size),
+      materialized(other.materialized.load(std::memory_order_acquire)) {
+  // element objects of typed storage are created again when needed
+  if (!this->materialized) return;
+
+  this->values.reserve(other.values.size());
+  for (size_t i = 0; i < other.values.size(); ++i)
+    this->values.push_back(other.values[i]->copy_as(other.key_at(i)));
+}
+
+ArrayData::~ArrayData() {
+  for (MemObject *obj : this->values) delete obj;
+}
+
+void ArrayData::materialize() const {
+  // typed storage may be read by several threads (parallel builtins)
+  static std::mutex materialize_lock;
+  std::lock_guard<std::mutex> guard(materialize_lock);
+  if (this->materialized.load(std::memory_order_relaxed)) return;
+
+  const double *numbers = this->number_data();
+  size_t count = this->size();
+  this->values.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    this->values.push_back(new MemObject(this->key_at(i), numbers[i]));
+
+  this->materialized.store(true, std::memory_order_release);
+}
+
+void ArrayData::make_generic() {
+  if (!this->typed) return;
+  if (!this->materialized.load(std::memory_order_acquire)) materialize();
+
+  this->typed = false;
+  std::vector<double>().swap(this->numbers);
+  this->source.reset();
+  this->borrowed = nullptr;
+  this->borrowed_size = 0;
+}
+
+void ArrayData::own_numbers() {
+  if (!this->source) return;
+
+  this->numbers.assign(this->borrowed, this->borrowed + this->borrowed_size);
+  this->source.reset();
+  this->borrowed = nullptr;
+  this->borrowed_size = 0;
+}
+
+size_t ArrayData::size() const {
+  if (this->source) return this->borrowed_size;
+  return this->typed ? this->numbers.size() : this->values.size();
+}
+
+const Shape *ArrayData::shape() const { return this->layout.get(); }
+
+std::shared_ptr<Shape> ArrayData::share_shape() const { return this->layout; }
+
+MemObject *ArrayData::get(Symbol key) const {
+  long pos = this->layout->offset(key);
+  if (pos < 0) return nullptr;
+  return this->at(pos);
+}
+
+Symbol ArrayData::key_at(size_t pos) const {
+  return this->layout->key_at(pos);
+}
+
+bool ArrayData::has_elements() const {
+  return this->materialized.load(std::memory_order_acquire);
+}
+
+bool ArrayData::is_typed() const { return this->typed; }
+
+const double *ArrayData::number_data() const {
+  if (this->source) return this->borrowed;
+  return this->typed ? this->numbers.data() : nullptr;
+}
+
+bool ArrayData::set(Symbol key, MemObject *value) {
+  // number keeps storage typed, element objects are updated with buffer
+  if (this->typed && value->get_type() != OBJECT_NUMBER) this->make_generic();
+  this->own_numbers();
+  if (this->typed && !this->materialized.load(std::memory_order_acquire))
+    this->materialize();
+
+  long pos = this->layout->offset(key);
+  if (pos >= 0) {
+    delete this->values[pos];
+    this->values[pos] = value;
+    if (this->typed) this->numbers[pos] = value->get_number();
+    return false;
+  }
+
+  this->layout = Shape::add(this->layout, key);
+  this->values.push_back(value);
+  if (this->typed) this->numbers.push_back(value->get_number());
+  return true;
+}
+
+bool ArrayData::remove(Symbol key) {
+  long pos = this->layout->offset(key);
+  if (pos < 0) return false;
+  this->own_numbers();
+  if (this->typed && !this->materialized.load(std::memory_order_acquire))
+    this->materialize();
+
+  if (this->layout->is_shared() || this->layout.use_count() > 1)
+    this->layout = std::make_shared<Shape>(*this->layout, false);
+  this->layout->erase(key);
+
+  delete this->values[pos];
+  this->values.erase(this->values.begin() + pos);
+  if (this->typed) this->numbers.erase(this->numbers.begin() + pos);
+
+  return true;
+}
+
+/**************************************************
+ *           MemArray Implementation
+ **************************************************/
+
+MemArray::MemArray(Symbol name, std::shared_ptr<ArrayData> data)
+    : MemObject(OBJECT_ARRAY, name, "(array)"), data(data) {}
+
+const ArrayData &MemArray::elements() const { return *this->data; }
+
+ArrayData &MemArray::mutable_elements() {
+  // storage is shared with other arrays, detach before write
+  if (this->data.use_count() > 1)
+    this->data = std::make_shared<ArrayData>(*this->data);
+  return *this->data;
+}
+
+std::shared_ptr<ArrayData> MemArray::share() const { return this->data; }
+
+MemObject *MemArray::copy_as(Symbol name) const {
+  return new MemArray(name, this->data);
+}
+
+/**************************************************
+ *           DictData Implementation
+ **************************************************/
+
+DictData::DictData() : live(0), slots(8, EMPTY), deleted(0) {}
+
+DictData::DictData(const DictData &other)
+    : live(0), slots(other.slots.size(), EMPTY), deleted(0) {
+  this->entries.reserve(other.live);
+  for (const Entry &entry : other.entries) {
+    if (!entry.value) continue;
+    this->entries.push_back({entry.key, entry.hash, entry.value->copy_as(0)});
+  }
+  this->live = this->entries.size();
+  this->rehash(this->slots.size());
+}
+
+DictData::~DictData() {
+  for (Entry &entry : this->entries) delete entry.value;
+}
+
+long DictData::find_slot(std::string_view key, size_t hash) const {
+  size_t mask = this->slots.size() - 1;
+
+  // linear probing, deleted slots do not stop the search
+  for (size_t i = hash & mask;; i = (i + 1) & mask) {
+    uint32_t slot = this->slots[i];
+    if (slot == EMPTY) return -1;
+    if (slot == DELETED) continue;
+
+    const Entry &entry = this->entries[slot - 2];
+    if (entry.hash == hash && entry.key == key) return i;
+  }
+}
+
+void DictData::rehash(size_t capacity) {
+  size_t kept = 0;
+  for (size_t i = 0; i < this->entries.size(); ++i) {
+    if (!this->entries[i].value) continue;
+    if (kept != i) this->entries[kept] = std::move(this->entries[i]);
+    ++kept;
+  }
+  this->entries.resize(kept);
+
+  this->slots.assign(capacity, EMPTY);
+  this->deleted = 0;
+  size_t mask = capacity - 1;
+  for (size_t pos = 0; pos < this->entries.size(); ++pos) {
+    size_t i = this->entries[pos].hash & mask;
+    while (this->slots[i] != EMPTY) i = (i + 1) & mask;
+    this->slots[i] = pos + 2;
+  }
+}
+
+size_t DictData::size() const { return this->live; }
+
+MemObject *DictData::get(std::string_view key) const {
+  long slot = find_slot(key, std::hash<std::string_view>()(key));
+  if (slot < 0) return nullptr;
+  return this->entries[this->slots[slot] - 2].value;
+}
+
+size_t DictData::span() const { return this->entries.size(); }
+
+MemObject *DictData::at(size_t pos) const { return this->entries[pos].value; }
+
+const std::string &DictData::key_at(size_t pos) const {
+  return this->entries[pos].key;
+}
+
+bool DictData::set(std::string_view key, MemObject *value) {
+  size_t hash = std::hash<std::string_view>()(key);
+  long slot = find_slot(key, hash);
+  if (slot >= 0) {
+    Entry &entry = this->entries[this->slots[slot] - 2];
+    delete entry.value;
+    entry.value = value;
+    return false;
+  }
+
+  // keep used slots (with deleted ones) below 3/4 of table
+  if ((this->live + this->deleted + 1) * 4 > this->slots.size() * 3) {
+    size_t capacity = this->slots.size();
+    while ((this->live + 1) * 2 > capacity) capacity *= 2;
+    this->rehash(capacity);
+  }
+
+  size_t mask = this->slots.size() - 1;
+  size_t i = hash & mask;
+  while (this->slots[i] != EMPTY && this->slots[i] != DELETED)
+    i = (i + 1) & mask;
+  if (this->slots[i] == DELETED) --this->deleted;
+
+  this->slots[i] = this->entries.size() + 2;
+  this->entries.push_back({std::string(key), hash, value});
+  ++this->live;
+  return true;
+}
+
+bool DictData::remove(std::string_view key) {
+  long slot = find_slot(key, std::hash<std::string_view>()(key));
+  if (slot < 0) return false;
+
+  Entry &entry = this->entries[this->slots[slot] - 2];
+  delete entry.value;
+  entry.value = nullptr;
+  std::string().swap(entry.key);
+
+  this->slots[slot] = DELETED;
+  ++this->deleted;
+  --this->live;
+
+  // holes are squeezed out once they outnumber entries
+  if (this->entries.size() > 2 * this->live + 8)
+    this->rehash(this->slots.size());
+  return true;
+}
+
+/**************************************************
+ *           MemDict Implementation
+ **************************************************/
+
+MemDict::MemDict(Symbol name, std::shared_ptr<DictData> data)
+    : MemObject(OBJECT_DICT, name, "(dict)"), data(data) {}
+
+const DictData &MemDict::entries() const { return *this->data; }
+
+DictData &MemDict::mutable_entries() {
+  // storage is shared with other dictionaries, detach before write
+  if (this->data.use_count() > 1)
+    this->data = std::make_shared<DictData>(*this->data);
+  return *this->data;
+}
+
+std::shared_ptr<DictData> MemDict::share() const { return this->data; }
+
+MemObject *MemDict::copy_as(Symbol name) const {
+  return new MemDict(name, this->data);
+}
+
 /**************************************************
  *           MemoryKernel Implementation
  **************************************************/
 
 bool MemoryKernel::put_primary_element(MemObject *obj) {
+  track_binding(obj);
+
   for (int k = this->scopes.size() - 1; k >= 0; --k) {
     auto &scope = scopes[k];
     for (int i = scope.size() - 1; i >= 0; --i) {
-      if (scope[i]->get_name() == obj->get_name()) {
+      if (scope[i]->get_symbol() == obj->get_symbol()) {
+        track_binding(scope[i]);
         delete scope[i];
         scope[i] = obj;
         return false;
@@ -146,6 +751,7 @@ bool MemoryKernel::put_primary_element(MemObject *obj) {
     }
   }
 
+  check_outer_write(obj->get_symbol());
   scopes[scopes.size() - 1].push_back(obj);
   return true;
 }
@@ -153,43 +759,41 @@ bool MemoryKernel::put_primary_element(MemObject *obj) {
 bool MemoryKernel::put_array_element(MemObject *obj) {
   /**
    * First, check out if the array exists, then
-   * if not - place element in the current scope.
-   * Otherwise place element in the scope of array
+   * if not - create it in the current scope.
+   * Otherwise place element in the storage of array
    */
 
-  std::string arr_name = extract_array_name(obj->get_name());
-  for (int k = this->scopes.size() - 1; k >= 0; --k) {
-    auto &scope = scopes[k];
-    bool isValidScope = false;
-    for (int i = scope.size() - 1; i >= 0; --i) {
-      if (!isValidScope && is_array_element(scope[i]->get_name()) &&
-          extract_array_name(scope[i]->get_name()) == arr_name) {
-        isValidScope = true;
-      }
+  Symbol array, key;
+  split_element(obj->get_name(), array, key, true);
+  return put_element(array, key, obj);
+}
 
-      if (scope[i]->get_name() == obj->get_name() && isValidScope) {
-        delete scope[i];
-        scope[i] = obj;
-        return false;
-      }  
-    }
-    if(isValidScope){
-      scope.push_back(obj);
-      return true;
-    }
-  }
+bool MemoryKernel::split_element(std::string_view name, Symbol &array,
+                                 Symbol &key, bool create) {
+  std::string_view arr_name = extract_array_name(name);
+  std::string_view key_name = name.substr(arr_name.size() + 1);
 
-  this->scopes[this->scopes.size() - 1].push_back(obj);
+  if (create) {
+    array = intern(arr_name);
+    key = intern(key_name);
+    return true;
+  }
 
-  return true;
+  const SymbolTable &table = SymbolTable::global();
+  return table.lookup(arr_name, array) && table.lookup(key_name, key);
 }
 
 MemoryKernel::MemoryKernel() {
   this->scopes = std::vector<std::vector<MemObject *>>();
   this->inside_func = false;
+  this->parent = nullptr;
 }
 
-MemObject *MemoryKernel::get_object(std::string name) const {
+MemoryKernel::MemoryKernel(const MemoryKernel *parent) : MemoryKernel() {
+  this->parent = parent;
+}
+
+MemObject *MemoryKernel::get_object(std::string_view name) const {
   /**
    * It is neccessary to traverse memory in inversed
    * order (from the deepest scope to the oldest)
@@ -199,16 +803,64 @@ MemObject *MemoryKernel::get_object(std::string name) const {
    * had been cleaned, the global variable should
    * become available again.
    */
+  Symbol symbol, key;
+  if (is_array_element(name)) {
+    if (!split_element(name, symbol, key, false)) return nullptr;
+    return get_element(symbol, key);
+  }
+
+  // name which was never interned can not be in memory
+  if (!SymbolTable::global().lookup(name, symbol)) return nullptr;
+  return get_object(symbol);
+}
+
+MemObject *MemoryKernel::get_object(Symbol name) const {
+  MemObject *obj = find_own(name);
+  if (!obj && parent) return parent->get_object(name);
+  return obj;
+}
+
+MemObject *MemoryKernel::find_own(Symbol name) const {
   for (int k = this->scopes.size() - 1; k >= 0; --k) {
     auto &scope = scopes[k];
     for (int i = scope.size() - 1; i >= 0; --i) {
-      if (scope[i]->get_name() == name) return scope[i];
+      if (scope[i]->get_symbol() == name) return scope[i];
     }
   }
 
   return nullptr;
 }
 
+void MemoryKernel::check_outer_write(Symbol name) const {
+  if (!parent || !parent->get_object(name)) return;
+
+  // other workers are running, so program is stopped without
+  // destruction of objects they may use
+  std::cout << "Can not write to '" << symbol_name(name)
+            << "': outer variable is read-only in parallel callback\n";
+  std::cout.flush();
+  std::_Exit(1);
+}
+
+MemArray *MemoryKernel::get_array(Symbol name) const {
+  return dynamic_cast<MemArray *>(get_object(name));
+}
+
+MemDict *MemoryKernel::get_dict(Symbol name) const {
+  return dynamic_cast<MemDict *>(get_object(name));
+}
+
+void MemoryKernel::check_modify(const MemObject *obj) const {
+  Symbol name = obj->get_symbol();
+  if (!parent || !name || find_own(name) == obj) return;
+  if (parent->get_object(name) == obj) check_outer_write(name);
+}
+
+MemObject *MemoryKernel::get_element(Symbol array, Symbol key) const {
+  MemArray *arr = get_array(array);
+  return arr ? arr->elements().get(key) : nullptr;
+}
+
 bool MemoryKernel::put_object(MemObject *obj) {
   if (is_array_element(obj->get_name()))
     return MemoryKernel::put_array_element(obj);
@@ -216,12 +868,32 @@ bool MemoryKernel::put_object(MemObject *obj) {
     return MemoryKernel::put_primary_element(obj);
 }
 
+bool MemoryKernel::put_element(Symbol array, Symbol key, MemObject *obj) {
+  /**
+   * First, check out if the array exists, then
+   * if not - create it in the current scope.
+   * Otherwise place element in the storage of array
+   */
+  MemArray *arr = dynamic_cast<MemArray *>(find_own(array));
+  if (arr) return arr->mutable_elements().set(key, obj);
+  check_outer_write(array);
+
+  arr = new MemArray(array, std::make_shared<ArrayData>());
+  arr->mutable_elements().set(key, obj);
+  put_primary_element(arr);
+
+  return true;
+}
+
 bool MemoryKernel::put_global(MemObject *obj) {
   if (scopes.size() < 1) return false;
 
+  track_binding(obj);
+
   auto &scope = scopes[0];
   for (int i = scope.size() - 1; i >= 0; --i) {
-    if (scope[i]->get_name() == obj->get_name()) {
+    if (scope[i]->get_symbol() == obj->get_symbol()) {
+      track_binding(scope[i]);
       delete scope[i];
       scope[i] = obj;
       return false;
@@ -232,10 +904,24 @@ bool MemoryKernel::put_global(MemObject *obj) {
   return true;
 }
 
-bool MemoryKernel::drop_object(std::string name) {
+bool MemoryKernel::drop_object(std::string_view name) {
+  Symbol symbol, key;
+  if (is_array_element(name)) {
+    if (!split_element(name, symbol, key, false)) return false;
+    MemArray *arr = get_array(symbol);
+    return arr && arr->mutable_elements().remove(key);
+  }
+
+  if (!SymbolTable::global().lookup(name, symbol)) return false;
+  return drop_object(symbol);
+}
+
+bool MemoryKernel::drop_object(Symbol name) {
   MemObject *obj = get_object(name);
   if (!obj) return false;
 
+  track_binding(obj);
+
   for (auto &scope : this->scopes) {
     for (int i = 0; i < scope.size(); ++i) {
       if (scope[i] == obj) scope.erase(scope.begin() + i);
@@ -251,7 +937,10 @@ void MemoryKernel::enter_scope() {
 
 void MemoryKernel::exit_scope() {
   int n = scopes.size() - 1;
-  for (int i = scopes[n].size() - 1; i >= 0; --i) delete scopes[n][i];
+  for (int i = scopes[n].size() - 1; i >= 0; --i) {
+    track_binding(scopes[n][i]);
+    delete scopes[n][i];
+  }
   scopes.pop_back();
 }
 
@@ -263,25 +952,31 @@ void MemoryKernel::dump_mem() const {
       for (int i = 0; i < depth; ++i) std::cout << "  ";
       std::cout << ObjectTypeStr(obj->get_type()) << " " << obj->get_name()
                 << " = " << obj->get_value() << "\n";
+
+      MemArray *arr = dynamic_cast<MemArray *>(obj);
+      if (!arr) continue;
+      const ArrayData &elements = arr->elements();
+      for (size_t j = 0; j < elements.size(); ++j) {
+        for (int i = 0; i <= depth; ++i) std::cout << "  ";
+        std::cout << ObjectTypeStr(elements.at(j)->get_type()) << " "
+                  << obj->get_name() << "@" << symbol_name(elements.key_at(j))
+                  << " = "
+                  << elements.at(j)->get_value() << "\n";
+      }
     }
     ++depth;
   }
   std::cout << "}\n";
 }
 
-std::vector<MemObject *> MemoryKernel::extract_array(std::string name) {
-  std::stringstream ss;
-  ss << "^" << name << "@..*";
+std::vector<MemObject *> MemoryKernel::extract_array(std::string_view name) {
+  std::vector<MemObject *> arr;
 
-  // pattern is "^NAME@..*"
-  std::regex pattern(ss.str());
+  MemArray *obj = dynamic_cast<MemArray *>(get_object(name));
+  if (!obj) return arr;
 
-  std::vector<MemObject *> arr;
-  for (auto &scope : this->scopes) {
-    for (MemObject *obj : scope) {
-      if (std::regex_match(obj->get_name(), pattern)) arr.push_back(obj);
-    }
-  }
+  const ArrayData &elements = obj->elements();
+  for (size_t i = 0; i < elements.size(); ++i) arr.push_back(elements.at(i));
 
   return arr;
 }
@@ -292,24 +987,143 @@ void MemoryKernel::unmark_inside_func() { this->inside_func = false; }
 
 bool MemoryKernel::is_inside_func() const { return this->inside_func; }
 
+std::vector<bool> MemoryKernel::func_names;
+
+unsigned long MemoryKernel::func_version = 0;
+
+thread_local bool MemoryKernel::worker = false;
+
+bool MemoryKernel::in_worker() { return worker; }
+
+void MemoryKernel::set_worker(bool on) { worker = on; }
+
+void MemoryKernel::track_binding(const MemObject *obj) {
+  // bindings of worker memory are not visible to other threads
+  // (calls made by workers do not use the cache)
+  if (worker) return;
+
+  Symbol name = obj->get_symbol();
+  if (obj->get_type() == OBJECT_FUNC) {
+    if (func_names.size() <= name) func_names.resize(name + 1, false);
+    func_names[name] = true;
+    ++func_version;
+  } else if (name < func_names.size() && func_names[name]) {
+    ++func_version;
+  }
+}
+
+unsigned long MemoryKernel::func_bindings_version() { return func_version; }
+
 /**************************************************
- *         Local Functions Implementation
+ *            CallFrame Implementation
  **************************************************/
 
-bool MemoryKernel::is_array_element(std::string name) {
-  static std::regex pattern("..*@..*");
-  return std::regex_match(name, pattern);
+// plain objects (not arrays, dictionaries and functions)
+// can be rebound in place
+static bool is_plain(const MemObject *obj) {
+  return obj->get_type() != OBJECT_ARRAY && obj->get_type() != OBJECT_DICT &&
+         obj->get_type() != OBJECT_FUNC;
 }
 
-static std::string extract_array_name(std::string name) {
-  std::stringstream ss;
+CallFrame::CallFrame(MemoryKernel &mem, const MemFunction &func)
+    : mem(mem), func(func) {
+  mem.enter_scope();
+  this->scope = mem.scopes.size() - 1;
+  for (Symbol arg : func.get_arg_names())
+    mem.scopes[scope].push_back(new MemObject(OBJECT_NULL, arg, "null"));
+}
+
+CallFrame::~CallFrame() {
+  mem.exit_scope();
+  mem.unmark_inside_func();
+}
 
-  for (auto &c : name) {
-    if (c == '@')
-      return ss.str();
-    else
-      ss << c;
+MemObject *&CallFrame::slot(size_t pos) {
+  Symbol arg = func.get_arg_names()[pos];
+  auto &objects = mem.scopes[scope];
+
+  // usually argument stays at its position
+  if (pos < objects.size() && objects[pos]->get_symbol() == arg)
+    return objects[pos];
+  for (auto &obj : objects)
+    if (obj->get_symbol() == arg) return obj;
+
+  objects.push_back(new MemObject(OBJECT_NULL, arg, "null"));
+  return objects.back();
+}
+
+void CallFrame::set_arg(size_t pos, const MemObject &value) {
+  MemObject *&obj = slot(pos);
+  if (is_plain(obj) && is_plain(&value) && obj->is_writable()) {
+    obj->assign(value);
+    return;
   }
 
-  return "";
+  MemoryKernel::track_binding(obj);
+  delete obj;
+  obj = value.copy_as(func.get_arg_names()[pos]);
+  MemoryKernel::track_binding(obj);
+}
+
+void CallFrame::set_arg(size_t pos, ObjectType type, std::string_view value) {
+  MemObject *&obj = slot(pos);
+  if (is_plain(obj) && obj->is_writable()) {
+    obj->set_type(type);
+    obj->set_text(value);
+    return;
+  }
+
+  MemoryKernel::track_binding(obj);
+  delete obj;
+  obj = new MemObject(type, func.get_arg_names()[pos], std::string(value));
+}
+
+MemObject *CallFrame::call() {
+  // nested calls inside of body unmark memory on their exit
+  mem.mark_inside_func();
+  static_cast<AST::Block *>(func.get_entry_point())->eval(mem);
+
+  static const Symbol ret_name = intern("$ret");
+  MemObject *ret = mem.get_object(ret_name);
+  if (ret) mem.drop_object(ret_name);
+  return ret;
+}
+
+/**************************************************
+ *         Local Functions Implementation
+ **************************************************/
+
+bool MemoryKernel::is_array_element(std::string_view name) {
+  // pattern is "..*@..*"
+  size_t pos = name.find('@');
+  return pos != std::string_view::npos && pos > 0 && pos + 1 < name.size();
+}
+
+static std::string_view extract_array_name(std::string_view name) {
+  size_t pos = name.find('@');
+  if (pos == std::string_view::npos) return std::string_view();
+  return name.substr(0, pos);
+}
+
+static bool whole_number(double number, long long &out) {
+  if (!(number >= -9.2e18 && number <= 9.2e18)) return false;
+  if (number != (long long)number) return false;
+  if (number == 0 && std::signbit(number)) return false;
+  out = (long long)number;
+  return true;
+}
+
+static bool index_of(Symbol key, size_t &out) {
+  const std::string &name = symbol_name(key);
+  // no sign and no leading zeros, as keys are made by `index_symbol`
+  if (name.empty() || name.size() > 18 || (name[0] == '0' && name.size() > 1))
+    return false;
+
+  size_t value = 0;
+  for (char c : name) {
+    if (c < '0' || c > '9') return false;
+    value = value * 10 + (c - '0');
+  }
+  out = value;
+  return true;
 }
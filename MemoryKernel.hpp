@@ -1,19 +1,31 @@
 #ifndef MEMORY_KERNEL_HPP
 #define MEMORY_KERNEL_HPP
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "symbols.hpp"
+
 /* All classess prototypes */
 class MemObject;
 class MemFunction;
+class Shape;
+class ArrayData;
+class MemArray;
+class DictData;
+class MemDict;
 class MemoryKernel;
+class CallFrame;
 /* End prototypes */
 
 /**
  * @brief Memory object type
  *
- * (arrays and tuples are processed separately)
+ * (arrays, tuples and dictionaries are processed separately)
  */
 enum ObjectType : int {
   OBJECT_STRING = 0,
@@ -22,15 +34,17 @@ enum ObjectType : int {
   OBJECT_FUNC,
   OBJECT_ARRAY,
   OBJECT_NULL,
+  OBJECT_DICT,
 };
 
-inline std::string ObjectTypeStr(ObjectType type) {
-  static std::vector<std::string> types = {
-    "string", "number", "bool", "func", "array",
+inline const std::string &ObjectTypeStr(ObjectType type) {
+  static const std::vector<std::string> types = {
+    "string", "number", "bool", "func", "array", "null", "dict",
   };
+  static const std::string undefined = "undefined";
 
   if (type < 0 || type >= types.size())
-    return "undefined";
+    return undefined;
   return types[type];
 }
 
@@ -41,34 +55,113 @@ inline std::string ObjectTypeStr(ObjectType type) {
 class MemObject {
  private:
   ObjectType type;
-  std::string name;
+  Symbol name;
   std::string value;
   bool writable;
 
+  // value parsed as number, filled on first `get_number`
+  // and dropped when value changes (atomic, as objects of outer
+  // scopes are read by callbacks of parallel builtins)
+  mutable std::atomic<double> number;
+  mutable std::atomic<bool> number_ready;
+
+  // whole number within long long is also kept exactly
+  // (valid while number is ready)
+  mutable std::atomic<long long> integer;
+  mutable std::atomic<bool> integral;
+
+  // parse value into number cache
+  void parse_number() const;
+
+  // fill number cache (value is set by caller)
+  void cache_number(double number, bool whole, long long integer) const;
+
+  // take parsed number of `from` (if it is ready)
+  void copy_number(const MemObject &from);
+
   // number of times object was used by other objects
   unsigned int num_references;
 
  public:
-  MemObject(ObjectType type, std::string name, std::string value);
+  MemObject(ObjectType type, Symbol name, std::string value);
+  MemObject(ObjectType type, std::string_view name, std::string value);
+
+  // number objects, value is formatted by `NumberFormat`
+  MemObject(Symbol name, double number);
+  MemObject(Symbol name, long long integer);
 
   // show warning if object was not used
   virtual ~MemObject();
 
   // getters
   ObjectType get_type() const;
-  std::string get_name() const;
-  std::string get_value() const;
+  Symbol get_symbol() const;
+  const std::string &get_name() const;
+  const std::string &get_value() const;
   unsigned int count_references() const;
+
+  // value as number (parsed once, while value stays the same)
+  double get_number() const;
+
+  // value as integer, false if it is not a whole number within long long
+  bool get_integer(long long &out) const;
   bool is_writable() const;
 
   // setters
   void set_type(ObjectType type);
   void set_value(std::string value);
+
+  // replace value in place (storage of old value is reused)
+  void set_text(std::string_view text);
+
+  // number value, formatted by `NumberFormat` (number is not parsed back)
+  void set_number(double number);
+  void set_integer(long long integer);
   void make_const();
 
+  // take type and value of other object (name stays the same,
+  // buffer of value is reused)
+  void assign(const MemObject &other);
+
+  // append text to value in place (amortized O(length of text))
+  void append_value(const std::string &text);
+
   // increment number of references
   // (needed to show warning if object was not used)
   void ref_inc();
+
+  /**
+   * @brief Make a copy of object under another name
+   *        (arrays share their elements with the copy,
+   *         see `MemArray`)
+   *
+   * @param name Name of the copy
+   * @return New object, owned by caller
+   */
+  virtual MemObject *copy_as(Symbol name) const;
+};
+
+/**
+ * @brief Immutable literals of the script
+ *
+ * Literal nodes take their objects from the pool at parse time,
+ * so evaluation of literal returns shared object without allocation.
+ * Equal literals share one object, numbers are parsed when added.
+ * Objects are not writable and live until the end of program
+ */
+class ConstantPool {
+ private:
+  std::map<std::pair<ObjectType, std::string>, MemObject *> objects;
+
+ public:
+  /**
+   * @brief Get constant object
+   *
+   * @param type Type of literal
+   * @param value Text of literal
+   * @return Shared object, must not be modified or deleted
+   */
+  static MemObject *get(ObjectType type, const std::string &value);
 };
 
 /**
@@ -83,9 +176,10 @@ class MemFunction : public MemObject {
 
   // names of arguments required by function
   // (required to prepare memory before function call)
-  std::vector<std::string> arg_names;
+  std::vector<Symbol> arg_names;
 
  public:
+  MemFunction(Symbol name, void *entry_point, std::vector<Symbol> arg_names);
   MemFunction(std::string name, void *entry_point,
               std::vector<std::string> arg_names);
 
@@ -94,7 +188,7 @@ class MemFunction : public MemObject {
   void *get_entry_point() const;
 
   // May be needed to fill arguments before function call
-  std::vector<std::string> get_arg_names() const;
+  const std::vector<Symbol> &get_arg_names() const;
 
   // Get number of arguments required by function
   unsigned int count_args();
@@ -113,6 +207,329 @@ class MemFunction : public MemObject {
    *         or wrong parameters are passed)
    */
   bool prep_mem(MemoryKernel &mem, std::vector<MemObject *> args);
+
+  MemObject *copy_as(Symbol name) const override;
+};
+
+/**
+ * @brief Shape (hidden class) of array or tuple:
+ *        keys in insertion order and their offsets in storage
+ *
+ * Shared shapes are immutable and are never freed while
+ * the program runs: they belong to declaration sites
+ * (all tuples built by the same `{a=.., b=..}` have
+ * the same shape) or to shapes they were derived from
+ * (adding a key follows cached transition). So pointer
+ * to shared shape can be used as cache key for field access.
+ *
+ * Private shapes belong to single storage and are modified
+ * in place (e.g. big arrays growing key by key).
+ *
+ */
+class Shape {
+ private:
+  std::vector<Symbol> keys;
+  std::unordered_map<Symbol, size_t> index;
+  bool shared;
+
+  // number of implicit keys "0".."implicit - 1" (see `Shape::indices`),
+  // they are not interned until shape is changed otherwise
+  size_t implicit;
+
+  // store implicit keys explicitly
+  void spell_out();
+
+  // shapes derived from shared shape by adding one key
+  std::unordered_map<Symbol, std::shared_ptr<Shape>> transitions;
+
+  // shared shapes bigger than this are not extended by transitions
+  static const size_t MAX_SHARED_KEYS = 32;
+
+ public:
+  Shape(bool shared);
+  Shape(const Shape &other, bool shared);
+  Shape &operator=(const Shape &other) = delete;
+
+  /**
+   * @brief Private shape with keys "0".."count - 1"
+   *
+   * Keys are implicit, so shape of any size is made in O(1)
+   * (used by arrays built by builtins)
+   */
+  static std::shared_ptr<Shape> indices(size_t count);
+
+  bool is_shared() const;
+  size_t size() const;
+  Symbol key_at(size_t pos) const;
+
+  // keys are "0".."size - 1", offset of key is its number
+  bool implicit_keys() const;
+
+  // offset of key or -1 if there is no such key
+  long offset(Symbol key) const;
+
+  // append key to private shape (key must not exist)
+  void append(Symbol key);
+
+  // remove key from private shape, later offsets are shifted
+  void erase(Symbol key);
+
+  /**
+   * @brief Shape with one more key appended
+   *
+   * @param self Shape to extend (one of its owners)
+   * @param key Key to append
+   * @return cached transition for shared shapes or private shape
+   *         extended in place (copied if `self` is used elsewhere)
+   */
+  static std::shared_ptr<Shape> add(std::shared_ptr<Shape> &self, Symbol key);
+};
+
+/**
+ * @brief Elements of array or tuple in insertion order
+ *
+ * Storage owns its elements. It is shared between all
+ * `MemArray` objects holding the same array (see `MemArray`)
+ *
+ * Typed storage keeps numbers in contiguous buffer (for numeric
+ * kernels, see `VecMath`). Element objects of typed storage are
+ * created on first access to them and kept in sync with buffer.
+ * Writing anything but a number to existing key turns typed
+ * storage into generic one
+ *
+ */
+class ArrayData {
+ private:
+  std::shared_ptr<Shape> layout;
+
+  // element objects (created on first access for typed storage)
+  mutable std::vector<MemObject *> values;
+
+  // buffer of typed storage
+  std::vector<double> numbers;
+  bool typed;
+
+  // read-only buffer kept alive by `source` (e.g. mapped file),
+  // used instead of `numbers` until the first write
+  std::shared_ptr<const void> source;
+  const double *borrowed;
+  size_t borrowed_size;
+
+  // copy borrowed buffer into `numbers`
+  void own_numbers();
+
+  // element objects are created (always true for generic storage)
+  mutable std::atomic<bool> materialized;
+
+  // create element objects of typed storage
+  void materialize() const;
+
+  // drop buffer, element objects become the only storage
+  void make_generic();
+
+ public:
+  ArrayData();
+
+  // elements laid out by given shape (storage takes ownership)
+  ArrayData(std::shared_ptr<Shape> shape, std::vector<MemObject *> values);
+
+  // typed storage of numbers laid out by given shape
+  ArrayData(std::shared_ptr<Shape> shape, std::vector<double> numbers);
+
+  /**
+   * @brief Typed storage over buffer it does not own (no copy)
+   *
+   * @param shape Shape with `count` keys
+   * @param source Owner of buffer, kept while storage uses it
+   * @param numbers Buffer, never written
+   * @param count Number of elements in buffer
+   */
+  ArrayData(std::shared_ptr<Shape> shape, std::shared_ptr<const void> source,
+            const double *numbers, size_t count);
+
+  // deep copy of all elements (shape is shared)
+  ArrayData(const ArrayData &other);
+  ArrayData &operator=(const ArrayData &other) = delete;
+
+  ~ArrayData();
+
+  // number of elements
+  size_t size() const;
+
+  // current shape of storage
+  const Shape *shape() const;
+
+  // extra reference to shape (for storage with the same keys)
+  std::shared_ptr<Shape> share_shape() const;
+
+  // element by key or nullptr if there is no such key
+  MemObject *get(Symbol key) const;
+
+  // element and its key by position (in insertion order)
+  MemObject *at(size_t pos) const {
+    if (!materialized.load(std::memory_order_acquire)) materialize();
+    return values[pos];
+  }
+  Symbol key_at(size_t pos) const;
+
+  // element objects exist (typed storage creates them on first access)
+  bool has_elements() const;
+
+  // storage keeps numbers in contiguous buffer
+  bool is_typed() const;
+
+  // buffer of typed storage (nullptr for generic storage)
+  const double *number_data() const;
+
+  /**
+   * @brief Put element, replacing old one with the same key
+   *        (storage takes ownership of the element)
+   *
+   * @return true if key did not exist before
+   * @return false if key existed before
+   */
+  bool set(Symbol key, MemObject *value);
+
+  /**
+   * @brief Remove element by key
+   *
+   * @return true if element was removed
+   * @return false if there was no such key
+   */
+  bool remove(Symbol key);
+};
+
+/**
+ * @brief Array (or tuple) object
+ *
+ * Elements are kept in `ArrayData` shared by reference:
+ * assignment of array to another variable or passing it to
+ * function only copies pointer to storage. Storage is copied
+ * once on first write to array which shares it (copy-on-write)
+ *
+ */
+class MemArray : public MemObject {
+ private:
+  std::shared_ptr<ArrayData> data;
+
+ public:
+  MemArray(Symbol name, std::shared_ptr<ArrayData> data);
+
+  // read-only access to elements
+  const ArrayData &elements() const;
+
+  // access for writing (copies storage if it is shared)
+  ArrayData &mutable_elements();
+
+  // extra reference to storage (e.g. to iterate over snapshot)
+  std::shared_ptr<ArrayData> share() const;
+
+  MemObject *copy_as(Symbol name) const override;
+};
+
+/**
+ * @brief Entries of dictionary in insertion order
+ *
+ * Keys are arbitrary strings (they are not interned, so
+ * transient keys do not grow symbol table). Entries are found
+ * by open addressing hash table of positions, removed entries
+ * leave holes which are squeezed out on rehash. Storage owns
+ * its values and is shared between all `MemDict` objects
+ * holding the same dictionary (see `MemDict`)
+ *
+ */
+class DictData {
+ private:
+  struct Entry {
+    std::string key;
+    size_t hash;
+    // nullptr for removed entry (hole)
+    MemObject *value;
+  };
+
+  // entries in insertion order
+  std::vector<Entry> entries;
+  size_t live;
+
+  // hash table of (position + 2), see EMPTY and DELETED
+  std::vector<uint32_t> slots;
+  size_t deleted;
+
+  static constexpr uint32_t EMPTY = 0;
+  static constexpr uint32_t DELETED = 1;
+
+  // slot holding key or -1 if there is no such key
+  long find_slot(std::string_view key, size_t hash) const;
+
+  // squeeze holes out of entries and rebuild table of given size
+  void rehash(size_t capacity);
+
+ public:
+  DictData();
+
+  // deep copy of all entries
+  DictData(const DictData &other);
+  DictData &operator=(const DictData &other) = delete;
+
+  ~DictData();
+
+  // number of entries
+  size_t size() const;
+
+  // value by key or nullptr if there is no such key
+  MemObject *get(std::string_view key) const;
+
+  /**
+   * @brief Positions of entries are 0..span()-1, value at
+   *        position of removed entry is nullptr
+   */
+  size_t span() const;
+  MemObject *at(size_t pos) const;
+  const std::string &key_at(size_t pos) const;
+
+  /**
+   * @brief Put value, replacing old one with the same key
+   *        (storage takes ownership of the value)
+   *
+   * @return true if key did not exist before
+   * @return false if key existed before
+   */
+  bool set(std::string_view key, MemObject *value);
+
+  /**
+   * @brief Remove entry by key
+   *
+   * @return true if entry was removed
+   * @return false if there was no such key
+   */
+  bool remove(std::string_view key);
+};
+
+/**
+ * @brief Dictionary object
+ *
+ * Entries are kept in `DictData` shared by reference, as
+ * elements of `MemArray`: storage is copied once on first
+ * write to dictionary which shares it (copy-on-write)
+ *
+ */
+class MemDict : public MemObject {
+ private:
+  std::shared_ptr<DictData> data;
+
+ public:
+  MemDict(Symbol name, std::shared_ptr<DictData> data);
+
+  // read-only access to entries
+  const DictData &entries() const;
+
+  // access for writing (copies storage if it is shared)
+  DictData &mutable_entries();
+
+  // extra reference to storage (e.g. to iterate over snapshot)
+  std::shared_ptr<DictData> share() const;
+
+  MemObject *copy_as(Symbol name) const override;
 };
 
 /**
@@ -124,23 +541,48 @@ class MemFunction : public MemObject {
  *     (e.g. warnings on unused variables, etc.)
  *  4. Functions management (check if number of arguments is correct, etc.)
  *  5. Additional array and tuple elements support
- *     (To store array or tuple it is needed to split it
- *      into primitives and store them separately with name in
+ *     (Arrays and tuples are stored as `MemArray` objects.
+ *      Separate elements are accessed with name in
  *      the following format: ARRAY_NAME@ELEMENT_NAME,
- *      e.g. if we declare `const a = [33, 22, 11]`, it should be
- *      saved in memory in 3 iterations: a@1=33, a@2=22, a@3=11.
- *      It is important to follow this convention as there are
- *      additional actions performed to array/tuple management)
+ *      e.g. if we declare `const a = [33, 22, 11]`, elements
+ *      can be reached as a@0=33, a@1=22, a@2=11. Putting object
+ *      with such name writes the element to array storage
+ *      (array is created if it did not exist before))
+ *  6. Memory of parallel callbacks: worker memory has its own
+ *     scopes and sees scopes of parent memory read-only
+ *     (writing to variable of parent memory is an error)
  *
  */
 class MemoryKernel {
   friend MemFunction;
+  friend CallFrame;
 
  private:
   // each element of scopes is a vector of objects in current scope
   std::vector<std::vector<MemObject *>> scopes;
   bool inside_func;
 
+  // memory which scopes are visible read-only (worker memory only)
+  const MemoryKernel *parent;
+
+  // set while current thread runs callback of parallel builtin
+  static thread_local bool worker;
+
+  // names (by symbol) which were ever bound to functions
+  static std::vector<bool> func_names;
+
+  // incremented on each change of function-valued binding
+  static unsigned long func_version;
+
+  /**
+   * @brief Should be called for each object which appears in memory
+   *        or leaves it. Bumps function bindings version, if object
+   *        is function or may shadow function with the same name
+   *
+   * @param obj Object which was added or removed
+   */
+  static void track_binding(const MemObject *obj);
+
   /**
    * @brief Save primary (not array) element into memory
    *
@@ -150,8 +592,25 @@ class MemoryKernel {
    */
   bool put_primary_element(MemObject *obj);
 
+  /**
+   * @brief Find object in own scopes (not in parent memory)
+   *
+   * @param name Symbol of objects name
+   * @return Pointer to object or nullptr if it does not exist
+   */
+  MemObject *find_own(Symbol name) const;
+
+  /**
+   * @brief Abort if `name` is visible only in parent memory
+   *        (parent memory is read-only for worker memory)
+   *
+   * @param name Symbol of name which is going to be written
+   */
+  void check_outer_write(Symbol name) const;
+
   /**
    * @brief Save array element into memory
+   *        (into storage of array, named by prefix of element name)
    *
    * @param obj Object to save
    * @return true if object did not exist before
@@ -159,9 +618,29 @@ class MemoryKernel {
    */
   bool put_array_element(MemObject *obj);
 
+  /**
+   * @brief Split ARRAY_NAME@ELEMENT_NAME into symbols of its parts
+   *
+   * @param name Element name
+   * @param array Receives symbol of ARRAY_NAME
+   * @param key Receives symbol of ELEMENT_NAME
+   * @param create Intern parts which were not interned yet
+   * @return false if some part is unknown (only if `create` is false)
+   */
+  static bool split_element(std::string_view name, Symbol &array,
+                            Symbol &key, bool create);
+
  public:
   MemoryKernel();
 
+  /**
+   * @brief Worker memory for callbacks of parallel builtins
+   *
+   * @param parent Memory which scopes are visible read-only
+   *        (must not change while worker memory is used)
+   */
+  explicit MemoryKernel(const MemoryKernel *parent);
+
   /**
    * @brief Get the object by name
    *
@@ -171,7 +650,49 @@ class MemoryKernel {
    * @param name Objects name
    * @return Pointer to object or nullptr if it does not exist
    */
-  MemObject *get_object(std::string name) const;
+  MemObject *get_object(std::string_view name) const;
+
+  /**
+   * @brief Get the object by interned name
+   *        (elements are not resolved, see `get_element`)
+   *
+   * @param name Symbol of objects name
+   * @return Pointer to object or nullptr if it does not exist
+   */
+  MemObject *get_object(Symbol name) const;
+
+  /**
+   * @brief Get array (or tuple) by name
+   *
+   * @param name Symbol of array name
+   * @return Array or nullptr if there is no such array
+   */
+  MemArray *get_array(Symbol name) const;
+
+  /**
+   * @brief Get dictionary by name
+   *
+   * @param name Symbol of dictionary name
+   * @return Dictionary or nullptr if there is no such dictionary
+   */
+  MemDict *get_dict(Symbol name) const;
+
+  /**
+   * @brief Abort if object is going to be modified in place
+   *        by worker memory, while it belongs to parent memory
+   *
+   * @param obj Object (e.g. dictionary) which is going to be modified
+   */
+  void check_modify(const MemObject *obj) const;
+
+  /**
+   * @brief Get array (or tuple) element
+   *
+   * @param array Symbol of array name
+   * @param key Symbol of element name
+   * @return Element or nullptr if it does not exist
+   */
+  MemObject *get_element(Symbol array, Symbol key) const;
 
   /**
    * @brief Put object to memory
@@ -182,6 +703,18 @@ class MemoryKernel {
    */
   bool put_object(MemObject *obj);
 
+  /**
+   * @brief Put element to array (or tuple),
+   *        array is created if it does not exist
+   *
+   * @param array Symbol of array name
+   * @param key Symbol of element name
+   * @param obj Element to save
+   * @return true if element did not exist before
+   * @return false if element existed before
+   */
+  bool put_element(Symbol array, Symbol key, MemObject *obj);
+
   /**
    * @brief Put object to global scope
    * 
@@ -199,7 +732,8 @@ class MemoryKernel {
    * @return true If object dropped successfully
    * @return false If object does not exist
    */
-  bool drop_object(std::string name);
+  bool drop_object(std::string_view name);
+  bool drop_object(Symbol name);
 
   /**
    * @brief Should be called on each new visibility scope entered
@@ -228,7 +762,7 @@ class MemoryKernel {
    * @param name Name of array
    * @return List of array elements
    */
-  std::vector<MemObject *> extract_array(std::string name);
+  std::vector<MemObject *> extract_array(std::string_view name);
 
   /**
    * @brief Mark memory that it is executed inside 
@@ -248,6 +782,25 @@ class MemoryKernel {
    */
   bool is_inside_func() const;
 
+  /**
+   * @brief Version of function bindings. Stays the same while
+   *        every name resolves to the same function object
+   *        (can be used to cache function lookups)
+   */
+  static unsigned long func_bindings_version();
+
+  /**
+   * @brief Check if current thread runs callback of parallel
+   *        builtin (shared caches must not be written then)
+   */
+  static bool in_worker();
+
+  /**
+   * @brief Mark current thread as running (or not running)
+   *        callback of parallel builtin
+   */
+  static void set_worker(bool on);
+
   /**
    * @brief Checks if name satisfies array element pattern
    *        (ARRAY_NAME@ARRAY_ELEMENT)
@@ -256,7 +809,56 @@ class MemoryKernel {
    * @return true If matches array element pattern
    * @return false If does not match array element pattern
    */
-  static bool is_array_element(std::string name);
+  static bool is_array_element(std::string_view name);
+};
+
+/**
+ * @brief Frame for repeated calls of one function
+ *        (e.g. callback of builtin, called for each array element)
+ *
+ * Scope with arguments is created once, between calls arguments
+ * are rebound in place: plain values reuse the same objects,
+ * so a call costs about as much as evaluation of function body
+ *
+ */
+class CallFrame {
+ private:
+  MemoryKernel &mem;
+  const MemFunction &func;
+
+  // index of frame scope in memory
+  size_t scope;
+
+  // argument object (found again, as function may reassign it)
+  MemObject *&slot(size_t pos);
+
+ public:
+  CallFrame(MemoryKernel &mem, const MemFunction &func);
+  ~CallFrame();
+
+  /**
+   * @brief Bind argument to copy of value
+   *
+   * @param pos Position of argument
+   * @param value New value of argument
+   */
+  void set_arg(size_t pos, const MemObject &value);
+
+  /**
+   * @brief Bind argument to plain value
+   *
+   * @param pos Position of argument
+   * @param type Type of value
+   * @param value Text of value
+   */
+  void set_arg(size_t pos, ObjectType type, std::string_view value);
+
+  /**
+   * @brief Call function with current arguments
+   *
+   * @return Returned object (owned by caller) or nullptr
+   */
+  MemObject *call();
 };
 
 #endif  // MEMORY_KERNEL_HPP
\ No newline at end of file
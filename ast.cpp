@@ -1,91 +1,219 @@
 #include "ast.hpp"
 #include <stdlib.h>
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "builtin.hpp"
+#include "diagnostics.hpp"
+#include "json.hpp"
+#include "numbers.hpp"
 
 namespace AST {
     MemObject *ASTNode::eval(MemoryKernel &mem) {
-        return new MemObject(OBJECT_NULL, "", "null");
+        return new MemObject(OBJECT_NULL, 0, "null");
     }
 
     MemObject* NullConst::eval(MemoryKernel& mem){
-        return new MemObject(OBJECT_NULL, "", "null");
+        return constant;
     }
 
     MemObject* NumberConst::eval(MemoryKernel& mem){
-        return new MemObject(OBJECT_NUMBER, "", value);
+        return constant;
     }
 
     MemObject* StringConst::eval(MemoryKernel& mem){
-        return new MemObject(OBJECT_STRING, "", value);
+        return constant;
+    }
+
+    MemObject* Interpolation::eval(MemoryKernel& mem){
+        // values of expressions are kept, so result is sized once
+        std::vector<MemObject*> values;
+        values.reserve(exprs.size());
+        size_t length = 0;
+        for (size_t i = 0; i < exprs.size(); i++) {
+            values.push_back(exprs[i]->eval(mem));
+            length += texts[i].size() + values[i]->get_value().size();
+        }
+        length += texts.back().size();
+
+        std::string result;
+        result.reserve(length);
+        for (size_t i = 0; i < values.size(); i++) {
+            result += texts[i];
+            result += values[i]->get_value();
+        }
+        result += texts.back();
+        return new MemObject(OBJECT_STRING, 0, std::move(result));
     }
 
     MemObject* BoolConst::eval(MemoryKernel& mem){
-        return new MemObject(OBJECT_BOOL, "", value);
+        return constant;
     }
 
     MemObject* Ident::eval(MemoryKernel& mem){
-        return mem.get_object(value);
+        return mem.get_object(symbol);
     }
 
     MemObject* VarType::eval(MemoryKernel& mem){
         
         if(value == "string")
-            return new MemObject(OBJECT_STRING, "", "");
+            return new MemObject(OBJECT_STRING, 0, "");
         else if(value == "bool")
-            return new MemObject(OBJECT_BOOL, "", "");
+            return new MemObject(OBJECT_BOOL, 0, "");
         else if(value == "number")
-            return new MemObject(OBJECT_NUMBER, "", "");
+            return new MemObject(OBJECT_NUMBER, 0, "");
         
-        return new MemObject(OBJECT_NULL, "", "");
+        return new MemObject(OBJECT_NULL, 0, "");
+    }
+
+    /**
+     * Checks if subtree contains function calls
+     * (without them expression has no side effects)
+     */
+    static bool has_calls(ASTNode* node) {
+        if (dynamic_cast<FuncCall*>(node)) return true;
+
+        std::vector<ASTNode*> children;
+        node->children(children);
+        for (ASTNode* child : children)
+            if (has_calls(child)) return true;
+        return false;
+    }
+
+    /**
+     * Appends values of `parts` to string `target` in place, as
+     * target = target + parts[0] + parts[1] + ... would do
+     *
+     * @return false if some value can not be appended to string
+     *         (nothing is changed then)
+     */
+    static bool append_in_place(MemObject* target, const std::vector<ASTNode*>& parts,
+                                MemoryKernel& mem) {
+        std::vector<MemObject*> values;
+        for (ASTNode* part : parts) {
+            MemObject* value = part->eval(mem);
+            if (!value) return false;
+            ObjectType type = value->get_type();
+            if (type != OBJECT_STRING && type != OBJECT_NUMBER &&
+                type != OBJECT_BOOL && type != OBJECT_NULL) return false;
+            values.push_back(value);
+        }
+
+        // target may appear again among parts (s = s + s), such
+        // parts are taken from its text before appending
+        size_t original = target->get_value().size();
+        for (MemObject* value : values) {
+            // string + null = string
+            if (value->get_type() == OBJECT_NULL) continue;
+            if (value == target)
+                target->append_value(target->get_value().substr(0, original));
+            else
+                target->append_value(value->get_value());
+        }
+        return true;
+    }
+
+    void Assign::analyze() {
+        append = APPEND_NO;
+        // walk s + a + b = ((s + a) + b) down to s
+        std::vector<ASTNode*> parts;
+        ASTNode* node = value;
+        Plus* plus;
+        while ((plus = dynamic_cast<Plus*>(node))) {
+            parts.insert(parts.begin(), &plus->right());
+            node = &plus->left();
+        }
+        Ident* self = dynamic_cast<Ident*>(node);
+        if (!parts.empty() && self && self->getSymbol() == name && mod.getMod() == "assign") {
+            append = APPEND_YES;
+            for (ASTNode* part : parts)
+                if (has_calls(part)) append = APPEND_NO;
+            append_parts = parts;
+        }
+    }
+
+    Assign::Assign(AssignMod &mod, Symbol arr, ASTNode &elem_index, ASTNode &rexpr) :
+        Assign(mod, arr, 0, rexpr) {
+        if (NumberConst* leaf = dynamic_cast<NumberConst*>(&elem_index)) {
+            key = intern(leaf->getValue());
+            name = intern(symbol_name(arr) + "@" + symbol_name(key));
+        } else {
+            index = &elem_index;
+            name = arr;
+        }
     }
 
     MemObject* Assign::eval(MemoryKernel& mem){
+        // nodes are shared by threads of parallel builtins,
+        // so workers never analyze (and never append in place,
+        // as target may belong to outer read-only scope)
+        bool worker = MemoryKernel::in_worker();
+        if (append == APPEND_UNKNOWN && !worker) analyze();
+
+        if (append == APPEND_YES && !worker) {
+            // parts have no calls, so they can not touch target and
+            // may be evaluated again by generic path if appending fails
+            MemObject* target = mem.get_object(this->name);
+            if (!isElement() && target && target->get_type() == OBJECT_STRING && target->is_writable() &&
+                append_in_place(target, append_parts, mem))
+                return new MemObject(OBJECT_NULL, 0, "null");
+        }
+
+
+        MemObject* container = isElement() ? mem.get_object(array) : nullptr;
+
+        // entry of dictionary is keyed by text of index
+        if (dynamic_cast<MemDict*>(container)) {
+            std::string entry = index ? ArrayEl::index_text(index->eval(mem)) : symbol_name(key);
+            MemObject* p = value->eval(mem)->copy_as(0);
+
+            // value may rebind dictionary (e.g. by call of function)
+            MemDict* dict = mem.get_dict(array);
+            if (!dict) {
+                std::cout << "Invalid reference to '" << symbol_name(array)
+                          << "': dictionary does not exist\n";
+                exit(1);
+            }
+            mem.check_modify(dict);
+            dict->mutable_entries().set(entry, p);
+            return new MemObject(OBJECT_NULL, 0, "null");
+        }
+
+        Symbol key = this->key;
+        if (index) key = ArrayEl::index_key(index->eval(mem), true);
+
+        MemArray* arr = dynamic_cast<MemArray*>(container);
+        MemObject* old = isElement() ? (arr ? arr->elements().get(key) : nullptr) : mem.get_object(name);
+
         // if we try to change object which does not exist,
         // then panic and exit
-        if (mod.getMod() == "assign" && !mem.get_object(this->name) && !mem.is_array_element(this->name)) {
-            std::cout << "Invalid reference to '" << this->name
+        if (mod.getMod() == "assign" && !old && !isElement()) {
+            std::cout << "Invalid reference to '" << getName()
                       << "': variable does not exist\n";
             exit(1);
         }
         
         // can not reassign const!
-        if (mod.getMod() == "assign" && mem.get_object(this->name) && !mem.get_object(this->name)->is_writable()){
-            std::cout << "Can not reassign '" << this->name << "'"
+        if (mod.getMod() == "assign" && old && !old->is_writable()){
+            std::cout << "Can not reassign '" << getName() << "'"
                       << ": variable is not writable\n";
             exit(1);
         }
 
-        MemObject* _eval = value.eval(mem);
-
-        if(_eval->get_type() == OBJECT_ARRAY){
+        MemObject* _eval = value->eval(mem);
 
-            std::vector<MemObject *> elements = mem.extract_array("_garr"); 
-            for (int i = 0; i < std::stoi(_eval->get_value()); i++)
-            {
-                std::string old_name = elements[i]->get_name();
-                std::string global_arr = "_garr@";
-                size_t pos = old_name.find(global_arr);
-                if (pos != std::string::npos) {
-                    old_name.replace(pos, global_arr.length(), "");
-                }
-                std::string new_name = this->name + "@" + old_name;
-                mem.put_object(new MemObject(elements[i]->get_type(), new_name, elements[i]->get_value()));
-                mem.drop_object(elements[i]->get_name());
-            }
-            mem.put_object(new MemObject(_eval->get_type(), this->name, _eval->get_value()));
-        }
-        else if (_eval->get_type() != OBJECT_FUNC) {
-            MemObject *p = new MemObject(_eval->get_type(), this->name, _eval->get_value());
-            if (mod.getMod() == "const") p->make_const();
-            mem.put_object(p);
-        } else {
-            MemFunction *_eval_f = dynamic_cast<MemFunction*>(_eval);
-            MemFunction *to_put_f = new MemFunction(this->name,
-                                                    _eval_f->get_entry_point(),
-                                                    _eval_f->get_arg_names());
-            mem.put_object(to_put_f);
-        }
+        // arrays and tuples share elements with the copy (copy-on-write),
+        // functions keep their entry point
+        MemObject *p = _eval->copy_as(index ? key : this->name);
+        if (mod.getMod() == "const") p->make_const();
+        if (isElement()) mem.put_element(array, key, p);
+        else mem.put_object(p);
 
-        return new MemObject(OBJECT_NULL, "", "null");
+        return new MemObject(OBJECT_NULL, 0, "null");
     }
 
     MemObject* Block::eval(MemoryKernel& mem) {
@@ -100,17 +228,17 @@ namespace AST {
 #endif /* DEBUG */
 
         mem.exit_scope();
-        return new MemObject(OBJECT_NULL, "", "null");
+        return new MemObject(OBJECT_NULL, 0, "null");
     }
 
     MemObject* If::eval(MemoryKernel& mem) {
         
-        MemObject* if_cond = cond.eval(mem);
+        MemObject* if_cond = cond->eval(mem);
         if(if_cond->get_type() == OBJECT_BOOL && if_cond->get_value() == "false"){
 
             return else_block.eval(mem);
             
-        }else if(if_cond->get_type() == OBJECT_NUMBER && if_cond->get_value() == "0"){
+        }else if(if_cond->get_type() == OBJECT_NUMBER && if_cond->get_number() == 0){
             
             return else_block.eval(mem);
 
@@ -123,21 +251,38 @@ namespace AST {
     }
 
     MemObject* Print::eval(MemoryKernel& mem) {
-        if(left.eval(mem)->get_type() == OBJECT_ARRAY){
-            std::vector<MemObject *> arr_elements = mem.extract_array(left.eval(mem)->get_name());
-            for(int i = 0; i < arr_elements.size(); i++){
-                if(arr_elements[i]->get_type() == OBJECT_STRING)
-                    std::cout<<'"'<<arr_elements[i]->get_value()<<'"';
+        MemObject* _eval = left->eval(mem);
+        MemArray* arr = dynamic_cast<MemArray*>(_eval);
+        if(arr){
+            const ArrayData& arr_elements = arr->elements();
+            for(size_t i = 0; i < arr_elements.size(); i++){
+                if(arr_elements.at(i)->get_type() == OBJECT_STRING)
+                    std::cout<<'"'<<arr_elements.at(i)->get_value()<<'"';
                 else
-                    std::cout<<arr_elements[i]->get_value();
+                    std::cout<<arr_elements.at(i)->get_value();
                     
                 if(i != arr_elements.size() - 1) 
                     std::cout<<", ";
                 else std::cout<<"\n";
             }
+        }else if(MemDict* dict = dynamic_cast<MemDict*>(_eval)){
+            const DictData& entries = dict->entries();
+            auto sep = "";
+            std::cout<<"{";
+            for(size_t i = 0; i < entries.span(); i++){
+                MemObject* value = entries.at(i);
+                if(!value) continue;
+                std::cout<<sep<<'"'<<entries.key_at(i)<<"\": ";
+                if(value->get_type() == OBJECT_STRING)
+                    std::cout<<'"'<<value->get_value()<<'"';
+                else
+                    std::cout<<value->get_value();
+                sep = ", ";
+            }
+            std::cout<<"}\n";
         }else
-            std::cout<<left.eval(mem)->get_value()<<"\n";
-        return new MemObject(OBJECT_NULL, "", "null");
+            std::cout<<_eval->get_value()<<"\n";
+        return new MemObject(OBJECT_NULL, 0, "null");
     }
 
     MemObject* Read::eval(MemoryKernel& mem){
@@ -156,133 +301,152 @@ namespace AST {
     }
 
     MemObject* IsOp::eval(MemoryKernel& mem){
-        MemObject* var = left_.eval(mem);
-        MemObject* type = right_.eval(mem);
+        MemObject* var = left_->eval(mem);
+        MemObject* type = right_->eval(mem);
         
         if(var->get_type() == OBJECT_NUMBER && type->get_type() == OBJECT_NUMBER){
-            return new MemObject(OBJECT_BOOL, "", "true");
+            return new MemObject(OBJECT_BOOL, 0, "true");
         } else if (var->get_type() == OBJECT_BOOL && type->get_type() == OBJECT_BOOL){
-            return new MemObject(OBJECT_BOOL, "", "true");
+            return new MemObject(OBJECT_BOOL, 0, "true");
         } else if (var->get_type() == OBJECT_STRING && type->get_type() == OBJECT_STRING){
-            return new MemObject(OBJECT_BOOL, "", "true");
+            return new MemObject(OBJECT_BOOL, 0, "true");
         } else if (var->get_type() == OBJECT_NULL && type->get_type() == OBJECT_NULL){
-            return new MemObject(OBJECT_BOOL, "", "true");
+            return new MemObject(OBJECT_BOOL, 0, "true");
+        }
+        return new MemObject(OBJECT_BOOL, 0, "false");
+    }
+
+    /**
+     * Arithmetic on two numbers: whole operands give exact integer
+     * result while it fits long long (overflow and fractional
+     * quotient fall back to double)
+     */
+    static MemObject* number_op(const MemObject* left, const MemObject* right, char op) {
+        long long a, b, r;
+        if (left->get_integer(a) && right->get_integer(b)) {
+            bool overflow;
+            switch (op) {
+                case '+': overflow = __builtin_add_overflow(a, b, &r); break;
+                case '-': overflow = __builtin_sub_overflow(a, b, &r); break;
+                case '*': overflow = __builtin_mul_overflow(a, b, &r); break;
+                default:
+                    overflow = b == 0 || (b == -1 && a == LLONG_MIN) || a % b != 0;
+                    if (!overflow) r = a / b;
+                    break;
+            }
+            if (!overflow) return new MemObject(0, r);
+        }
+
+        double first = left->get_number();
+        double second = right->get_number();
+        switch (op) {
+            case '+': return new MemObject(0, first + second);
+            case '-': return new MemObject(0, first - second);
+            case '*': return new MemObject(0, first * second);
+            default: return new MemObject(0, first / second);
         }
-        return new MemObject(OBJECT_BOOL, "", "false");
     }
 
     MemObject* Plus::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // number + number = number
         if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
-            double first, second;
-            std::stringstream _l(left->get_value());
-            std::stringstream _r(right->get_value());
-            _l >> first;
-            _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first + second));
+            return number_op(left, right, '+');
         }
 
         // string + string = string
         else if (left->get_type() == OBJECT_STRING && right->get_type() == OBJECT_STRING) {
-            return new MemObject(OBJECT_STRING, "", left->get_value() + right->get_value());
+            return new MemObject(OBJECT_STRING, 0, left->get_value() + right->get_value());
         }
 
         // bool + bool = bool
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_BOOL) {
             if (left->get_value() == "true" || right->get_value() == "true") {
-                return new MemObject(OBJECT_BOOL, "", "true");
+                return new MemObject(OBJECT_BOOL, 0, "true");
             }
-            return new MemObject(OBJECT_BOOL, "", "false");
+            return new MemObject(OBJECT_BOOL, 0, "false");
         }
 
         // null + null = null
         else if (left->get_type() == OBJECT_NULL && right->get_type() == OBJECT_NULL) {
-            return new MemObject(OBJECT_NULL, "", "null");
+            return new MemObject(OBJECT_NULL, 0, "null");
         }
 
         // number + string = string
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_STRING) {
-            return new MemObject(OBJECT_STRING, "", left->get_value() + right->get_value());
+            return new MemObject(OBJECT_STRING, 0, left->get_value() + right->get_value());
         }
         else if (left->get_type() == OBJECT_STRING && right->get_type() == OBJECT_NUMBER) {
-            return new MemObject(OBJECT_STRING, "", left->get_value() + right->get_value());
+            return new MemObject(OBJECT_STRING, 0, left->get_value() + right->get_value());
         }
 
         // number + bool = num + 0/1
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_BOOL) {
             double first, second;
-            std::stringstream _l(left->get_value());
             std::string _bool = "0";
             if (right->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = left->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first + second));
+            return new MemObject(0, first + second);
         }
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_NUMBER) {
             double first, second;
-            std::stringstream _l(right->get_value());
             std::string _bool = "0";
             if (left->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = right->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first + second));
+            return new MemObject(0, first + second);
         }
 
         // num + null = num
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NULL) {
-            return new MemObject(OBJECT_NUMBER, "", left->get_value());
+            return new MemObject(OBJECT_NUMBER, 0, left->get_value());
         }
         else if (left->get_type() == OBJECT_NULL && right->get_type() == OBJECT_NUMBER) {
-            return new MemObject(OBJECT_NUMBER, "", right->get_value());
+            return new MemObject(OBJECT_NUMBER, 0, right->get_value());
         }
 
         // string + bool = string
         else if (left->get_type() == OBJECT_STRING && right->get_type() == OBJECT_BOOL) {
-            return new MemObject(OBJECT_STRING, "", left->get_value() + right->get_value());
+            return new MemObject(OBJECT_STRING, 0, left->get_value() + right->get_value());
         }
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_STRING) {
-            return new MemObject(OBJECT_STRING, "", left->get_value() + right->get_value());
+            return new MemObject(OBJECT_STRING, 0, left->get_value() + right->get_value());
         }
 
         // string + null = string
         else if (left->get_type() == OBJECT_STRING && right->get_type() == OBJECT_NULL) {
-            return new MemObject(OBJECT_STRING, "", left->get_value());
+            return new MemObject(OBJECT_STRING, 0, left->get_value());
         }
         else if (left->get_type() == OBJECT_NULL && right->get_type() == OBJECT_STRING) {
-            return new MemObject(OBJECT_STRING, "", right->get_value());
+            return new MemObject(OBJECT_STRING, 0, right->get_value());
         }
 
         // bool + null = bool
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_NULL) {
-            return new MemObject(OBJECT_BOOL, "", left->get_value());
+            return new MemObject(OBJECT_BOOL, 0, left->get_value());
         }
         else if (left->get_type() == OBJECT_NULL && right->get_type() == OBJECT_BOOL) {
-            return new MemObject(OBJECT_BOOL, "", right->get_value());
+            return new MemObject(OBJECT_BOOL, 0, right->get_value());
         }
 
         // FIXME: throw error
         else {
-            return new MemObject(OBJECT_NULL, "", "null");
+            return new MemObject(OBJECT_NULL, 0, "null");
         }
     }
 
     MemObject* Minus::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // number - number = number
         if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
-            double first, second;
-            std::stringstream _l(left->get_value());
-            std::stringstream _r(right->get_value());
-            _l >> first;
-            _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return number_op(left, right, '-');
         }
 
         // bool - bool = 0/1 - 0/1
@@ -296,101 +460,93 @@ namespace AST {
             std::stringstream _r(_bool_r);
             _l >> first;
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return new MemObject(0, first - second);
         }
 
         // number - bool = num - 0/1
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_BOOL) {
             double first, second;
-            std::stringstream _l(left->get_value());
             std::string _bool = "0";
             if (right->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = left->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return new MemObject(0, first - second);
         }
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_NUMBER) {
             double first, second;
-            std::stringstream _l(right->get_value());
             std::string _bool = "0";
             if (left->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = right->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return new MemObject(0, first - second);
         }
 
         else {
-            return new MemObject(OBJECT_NULL, "", "null");
+            return new MemObject(OBJECT_NULL, 0, "null");
         }
     }
 
-    MemObject* Times::eval(MemoryKernel& mem){
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
-
+    /**
+     * Product of evaluated operands (shared by Times and Reduced)
+     */
+    static MemObject* times(MemObject* left, MemObject* right) {
         // number * number = number
         if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
-            double first, second;
-            std::stringstream _l(left->get_value());
-            std::stringstream _r(right->get_value());
-            _l >> first;
-            _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first * second));
+            return number_op(left, right, '*');
         }
 
         // bool * bool = bool
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_BOOL) {
             if (left->get_value() == "false" || right->get_value() == "false") {
-                return new MemObject(OBJECT_BOOL, "", "false");
+                return new MemObject(OBJECT_BOOL, 0, "false");
             }
-            return new MemObject(OBJECT_NUMBER, "", "true");
+            return new MemObject(OBJECT_BOOL, 0, "true");
         }
 
         // number * bool = num * 0/1
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_BOOL) {
             double first, second;
-            std::stringstream _l(left->get_value());
             std::string _bool = "0";
             if (right->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = left->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first * second));
+            return new MemObject(0, first * second);
         }
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_NUMBER) {
             double first, second;
-            std::stringstream _l(right->get_value());
             std::string _bool = "0";
             if (left->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = right->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first * second));
+            return new MemObject(0, first * second);
         }
 
         else {
-            return new MemObject(OBJECT_NULL, "", "null");
+            return new MemObject(OBJECT_NULL, 0, "null");
         }
     }
 
+    MemObject* Times::eval(MemoryKernel& mem){
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
+        return times(left, right);
+    }
+
     MemObject* Div::eval(MemoryKernel& mem){
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // number / number = number
         if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
-            if (right->get_value() == "0") {
+            if (right->get_number() == 0) {
                 // TODO: throw error
-                return new MemObject(OBJECT_NULL, "", "null");
+                return new MemObject(OBJECT_NULL, 0, "null");
             }
-            double first, second;
-            std::stringstream _l(left->get_value());
-            std::stringstream _r(right->get_value());
-            _l >> first;
-            _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first / second));
+            return number_op(left, right, '/');
         }
         
         // bool / bool = 0/1 / 0/1
@@ -404,228 +560,950 @@ namespace AST {
             std::stringstream _r(_bool_r);
             if (_bool_r == "0") {
                 // TODO: throw error
-                return new MemObject(OBJECT_NULL, "", "null");
+                return new MemObject(OBJECT_NULL, 0, "null");
             }
             _l >> first;
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return new MemObject(0, first - second);
         }
         
         // number / bool = num / 0/1
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_BOOL) {
             double first, second;
-            std::stringstream _l(left->get_value());
             std::string _bool = "0";
             if (right->get_value() == "true") _bool = "1";
             if (_bool == "0") {
                 // TODO: throw error
-                return new MemObject(OBJECT_NULL, "", "null");
+                return new MemObject(OBJECT_NULL, 0, "null");
             }
             std::stringstream _r(_bool);
-            _l >> first;
+            first = left->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return new MemObject(0, first - second);
         }
         else if (left->get_type() == OBJECT_BOOL && right->get_type() == OBJECT_NUMBER) {
-            if (right->get_value() == "0") {
+            if (right->get_number() == 0) {
                 // TODO: throw error
-                return new MemObject(OBJECT_NULL, "", "null");
+                return new MemObject(OBJECT_NULL, 0, "null");
             }
             double first, second;
-            std::stringstream _l(right->get_value());
             std::string _bool = "0";
             if (left->get_value() == "true") _bool = "1";
             std::stringstream _r(_bool);
-            _l >> first;
+            first = right->get_number();
             _r >> second;
-            return new MemObject(OBJECT_NUMBER, "", std::to_string(first - second));
+            return new MemObject(0, first - second);
         }
 
         else {
-            return new MemObject(OBJECT_NULL, "", "null");
+            return new MemObject(OBJECT_NULL, 0, "null");
         }
     };
 
+    // order of numbers (whole numbers are compared exactly)
+    static bool number_less(const MemObject* left, const MemObject* right) {
+        long long a, b;
+        if (left->get_integer(a) && right->get_integer(b)) return a < b;
+        return left->get_number() < right->get_number();
+    }
+
+    static bool number_equal(const MemObject* left, const MemObject* right) {
+        long long a, b;
+        if (left->get_integer(a) && right->get_integer(b)) return a == b;
+        return left->get_number() == right->get_number();
+    }
+
     MemObject* Equals::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         bool eq = false;
 
         if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER){
-            double _left, _right;
-            std::stringstream _l, _r;
-            _l << left->get_value();
-            _r << right->get_value();
-
-            _l >> _left;
-            _r >> _right;
-            eq = (_left == _right);
+            eq = number_equal(left, right);
         } else if (left->get_value() == right->get_value()) {
             eq = true;
         }
 
-        return new MemObject(OBJECT_BOOL, "", eq ? "true": "false");
+        return new MemObject(OBJECT_BOOL, 0, eq ? "true": "false");
     }
 
     MemObject* Not::eval(MemoryKernel& mem) {
-        MemObject* _left = left.eval(mem);
+        MemObject* _left = left->eval(mem);
 
         if (_left->get_value() == "true") {
-            return new MemObject(OBJECT_BOOL, "", "false");
+            return new MemObject(OBJECT_BOOL, 0, "false");
         }
 
-        return new MemObject(OBJECT_BOOL, "", "true");
+        return new MemObject(OBJECT_BOOL, 0, "true");
     }
 
     MemObject* Not_Equals::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
-        MemObject* _equals = (new Equals(left_, right_))->eval(mem);
+        MemObject* _equals = (new Equals(*left_, *right_))->eval(mem);
 
         if (_equals->get_value() == "true") {
-            return new MemObject(OBJECT_BOOL, "", "false");
+            return new MemObject(OBJECT_BOOL, 0, "false");
         }
 
-        return new MemObject(OBJECT_BOOL, "", "true");
+        return new MemObject(OBJECT_BOOL, 0, "true");
     }
 
     MemObject* And::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // bool and bool
         if (left->get_type() == OBJECT_BOOL && left->get_type() == OBJECT_BOOL) {
-            return (new Times(left_, right_))->eval(mem);
+            return (new Times(*left_, *right_))->eval(mem);
         }
         // TODO:  Add number support 
         else {
-            return new MemObject(OBJECT_BOOL, "", "false");
+            return new MemObject(OBJECT_BOOL, 0, "false");
         }
     }
 
     MemObject* Or::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // bool and bool
         if (left->get_type() == OBJECT_BOOL && left->get_type() == OBJECT_BOOL) {
-            return (new Plus(left_, right_))->eval(mem);
+            return (new Plus(*left_, *right_))->eval(mem);
         }
         // TODO:  Add number support 
         else {
-            return new MemObject(OBJECT_BOOL, "", "false");
+            return new MemObject(OBJECT_BOOL, 0, "false");
         }
     }
 
     MemObject* Less::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // строки
         if (left->get_type() == OBJECT_STRING || right->get_type() == OBJECT_STRING) {
             if (left->get_value().compare(right->get_value()) < 0) {
-                return new MemObject(OBJECT_BOOL, "", "true");
+                return new MemObject(OBJECT_BOOL, 0, "true");
             }
         }
         // числа
         else if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
-            MemObject* _subtract = (new Minus(left_, right_))->eval(mem);
-
-            double _sub_value;
-            std::stringstream _l(_subtract->get_value());
-            _l >> _sub_value;
-            if (_sub_value < 0) {
-                return new MemObject(OBJECT_BOOL, "", "true");
+            if (number_less(left, right)) {
+                return new MemObject(OBJECT_BOOL, 0, "true");
             }
         }
 
-        return new MemObject(OBJECT_BOOL, "", "false");
+        return new MemObject(OBJECT_BOOL, 0, "false");
     }
 
     MemObject* Less_E::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
+
+        // числа сравниваются сразу, без повторного вычисления операндов
+        if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
+            bool holds = number_less(left, right) || number_equal(left, right);
+            return new MemObject(OBJECT_BOOL, 0, holds ? "true" : "false");
+        }
 
-        Less _less = Less(left_, right_);
-        Equals _equals = Equals(left_, right_);
+        Less _less = Less(*left_, *right_);
+        Equals _equals = Equals(*left_, *right_);
 
         return (new Plus(_less, _equals))->eval(mem);
     }
 
     MemObject* Greater::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
 
         // строки
         if (left->get_type() == OBJECT_STRING || right->get_type() == OBJECT_STRING) {
             if (left->get_value().compare(right->get_value()) > 0) {
-                return new MemObject(OBJECT_BOOL, "", "true");
+                return new MemObject(OBJECT_BOOL, 0, "true");
             }
         }
         // числа
         if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
-            MemObject* _subtract = (new Minus(left_, right_))->eval(mem);
-
-            double _sub_value;
-            std::stringstream _l(_subtract->get_value());
-            _l >> _sub_value;
-            if (_sub_value > 0) {
-                return new MemObject(OBJECT_BOOL, "", "true");
+            if (number_less(right, left)) {
+                return new MemObject(OBJECT_BOOL, 0, "true");
             }
         }
 
-        return new MemObject(OBJECT_BOOL, "", "false");
+        return new MemObject(OBJECT_BOOL, 0, "false");
     }
 
     MemObject* Greater_E::eval(MemoryKernel& mem) {
-        MemObject* left = left_.eval(mem);
-        MemObject* right = right_.eval(mem);
+        MemObject* left = left_->eval(mem);
+        MemObject* right = right_->eval(mem);
+
+        // числа сравниваются сразу, без повторного вычисления операндов
+        if (left->get_type() == OBJECT_NUMBER && right->get_type() == OBJECT_NUMBER) {
+            bool holds = number_less(right, left) || number_equal(left, right);
+            return new MemObject(OBJECT_BOOL, 0, holds ? "true" : "false");
+        }
 
-        Greater _greater = Greater(left_, right_);
-        Equals _equals = Equals(left_, right_);
+        Greater _greater = Greater(*left_, *right_);
+        Equals _equals = Equals(*left_, *right_);
 
         return (new Plus(_greater, _equals))->eval(mem);
     }
 
+    /**
+     * Last product of Reduced node: counter * factor = value,
+     * next step of counter adds `delta` (step * factor)
+     */
+    struct ReducedState {
+        bool known = false;
+        long long counter, factor, value, delta;
+    };
+
+    /**
+     * Values of Hoisted and Reduced nodes for one run of optimized
+     * While loop. Frames of running loops form a stack per thread
+     * (workers of parallel builtins run the same nodes)
+     */
+    struct LoopFrame {
+        const While* loop;
+        std::vector<MemObject*> values;
+        std::vector<ReducedState> products;
+        LoopFrame* outer;
+
+        static thread_local LoopFrame* top;
+
+        // frame without loop is not pushed (loop is not optimized)
+        LoopFrame(const While* loop, size_t hoisted, size_t reduced) :
+            loop{loop}, outer{top} {
+            if (!loop) return;
+            values.resize(hoisted, nullptr);
+            products.resize(reduced);
+            top = this;
+        }
+
+        ~LoopFrame() {
+            if (loop) top = outer;
+        }
+
+        // innermost run of `loop` on this thread
+        static LoopFrame* find(const While* loop) {
+            for (LoopFrame* frame = top; frame; frame = frame->outer)
+                if (frame->loop == loop) return frame;
+            return nullptr;
+        }
+    };
+
+    thread_local LoopFrame* LoopFrame::top = nullptr;
+
     MemObject* While::eval(MemoryKernel& mem) {
+        // workers do not write shared nodes, unknown loop is plain for them
+        if (shape == LOOP_UNKNOWN && !MemoryKernel::in_worker()) analyze();
+
+        LoopFrame frame(shape == LOOP_OPTIMIZED ? this : nullptr, hoisted, reduced);
         while (true) {
-            MemObject* res = while_cond.eval(mem);
+            MemObject* res = while_cond->eval(mem);
 
             if (res->get_type() == OBJECT_BOOL && res->get_value() == "false") break;
-            else if (res->get_type() == OBJECT_NUMBER && res->get_value() == "0") break;
+            else if (res->get_type() == OBJECT_NUMBER && res->get_number() == 0) break;
             else if (res->get_type() == OBJECT_NULL) break;
             while_block.eval(mem); 
         }
-        return new MemObject(OBJECT_NULL, "", "null");
+        return new MemObject(OBJECT_NULL, 0, "null");
         
     }
 
+    CompExp::CompExp(ASTNode &i, ASTNode &o, ASTNode &v) :
+        ident{i}, oper{o}, val{v} {
+        std::string kind = static_cast<LeafNode&>(oper).getValue();
+        if (kind == "Plus") op = new Plus(ident, val);
+        else if (kind == "Minus") op = new Minus(ident, val);
+        else if (kind == "Mul") op = new Times(ident, val);
+        else op = new Div(ident, val);
+        pure_val = !has_calls(&val);
+    }
+
+    MemObject* CompExp::eval(MemoryKernel& mem) {
+        MemObject* target = ident.eval(mem);
+        if (!target) {
+            Ident* named = dynamic_cast<Ident*>(&ident);
+            std::cout << "Invalid reference to '"
+                      << (named ? named->getValue() : std::string("?"))
+                      << "': variable does not exist\n";
+            exit(1);
+        }
+
+        // name is captured before `op` is evaluated, as the right side
+        // may reassign (and so delete) the target object
+        TupleEl* element = dynamic_cast<TupleEl*>(&ident);
+        Symbol name = element ? element->element_key(mem) : target->get_symbol();
+        if (!target->is_writable()) {
+            std::cout << "Can not reassign '";
+            if (element) std::cout << symbol_name(element->getTuple()) << "@";
+            std::cout << symbol_name(name) << "'"
+                      << ": variable is not writable\n";
+            exit(1);
+        }
+
+        // s += a on string variable appends in place
+        // (not by workers, target may belong to outer read-only scope)
+        if (!element && !MemoryKernel::in_worker() && target->get_type() == OBJECT_STRING &&
+            dynamic_cast<Plus*>(op) && pure_val &&
+            append_in_place(target, {&val}, mem))
+            return new MemObject(OBJECT_NULL, 0, "null");
+
+        MemObject* _eval = op->eval(mem);
+        MemObject* result = _eval->copy_as(name);
+        if (element) mem.put_element(element->getTuple(), name, result);
+        else mem.put_object(result);
+
+        return new MemObject(OBJECT_NULL, 0, "null");
+    }
+
+    /**
+     * Symbol written by node (assign, compound assign, read) or 0
+     */
+    static Symbol written_symbol(ASTNode* node) {
+        if (Assign* assign = dynamic_cast<Assign*>(node)) return assign->getTarget();
+        if (Read* read = dynamic_cast<Read*>(node)) return read->getSymbol();
+        if (CompExp* comp = dynamic_cast<CompExp*>(node)) {
+            if (TupleEl* element = dynamic_cast<TupleEl*>(&comp->getIdent()))
+                return element->getTuple();
+            if (Ident* ident = dynamic_cast<Ident*>(&comp->getIdent()))
+                return ident->getSymbol();
+        }
+        return 0;
+    }
+
+    /**
+     * Looks through subtree and reports if `name` is written
+     * (assign, compound assign, read) and if any function is called
+     */
+    static void scan_writes(ASTNode* node, const std::string& name,
+                            bool& writes, bool& calls) {
+        if (Assign* assign = dynamic_cast<Assign*>(node)) {
+            std::string target = assign->getName();
+            if (target == name || target.rfind(name + "@", 0) == 0) writes = true;
+        } else if (Read* read = dynamic_cast<Read*>(node)) {
+            if (read->getName() == name) writes = true;
+        } else if (CompExp* comp = dynamic_cast<CompExp*>(node)) {
+            // first child is the written variable
+            std::vector<ASTNode*> operands;
+            comp->children(operands);
+            Ident* target = dynamic_cast<Ident*>(operands[0]);
+            if (target && target->getValue() == name) writes = true;
+        } else if (dynamic_cast<FuncCall*>(node)) {
+            calls = true;
+        }
+
+        std::vector<ASTNode*> children;
+        node->children(children);
+        for (ASTNode* child : children) scan_writes(child, name, writes, calls);
+    }
+
+    /**
+     * Checks that limit of counted loop is far away from
+     * the range where counter may overflow
+     */
+    static bool counter_limit(long long value) {
+        return value <= 1000000000000000LL && value >= -1000000000000000LL;
+    }
+
+    void For::analyze() {
+        shape = SHAPE_GENERIC;
+
+        // for var i = <start>; ...
+        if (nodes.size() != 1) return;
+        Assign* decl = dynamic_cast<Assign*>(nodes[0]);
+        if (!decl || MemoryKernel::is_array_element(decl->getName())) return;
+        std::string name = decl->getName();
+
+        // ...; i < <bound>; ...
+        BinOp* compare = dynamic_cast<BinOp*>(&cond);
+        if (dynamic_cast<Less*>(&cond)) cmp = CMP_LESS;
+        else if (dynamic_cast<Less_E*>(&cond)) cmp = CMP_LESS_E;
+        else if (dynamic_cast<Greater*>(&cond)) cmp = CMP_GREATER;
+        else if (dynamic_cast<Greater_E*>(&cond)) cmp = CMP_GREATER_E;
+        else return;
+
+        Ident* lhs = dynamic_cast<Ident*>(&compare->left());
+        if (!lhs || lhs->getValue() != name) return;
+
+        std::string bound_name;
+        if (Ident* rhs = dynamic_cast<Ident*>(&compare->right())) {
+            bound_name = rhs->getValue();
+            if (bound_name == name) return;
+        } else if (!dynamic_cast<NumberConst*>(&compare->right())) {
+            return;
+        }
+
+        // ...; i += <const>
+        CompExp* step_exp = dynamic_cast<CompExp*>(&iter);
+        if (!step_exp) return;
+        Ident* step_ident = dynamic_cast<Ident*>(&step_exp->ident);
+        NumberConst* step_val = dynamic_cast<NumberConst*>(&step_exp->val);
+        if (!step_ident || step_ident->getValue() != name || !step_val) return;
+
+        std::string kind = static_cast<LeafNode&>(step_exp->oper).getValue();
+        long long delta;
+        if (!NumberFormat::parse_integer(step_val->getValue(), delta) ||
+            !counter_limit(delta) || delta == 0) return;
+        if (kind == "Minus") delta = -delta;
+        else if (kind != "Plus") return;
+
+        // step must move counter towards the bound
+        bool ascending = (cmp == CMP_LESS || cmp == CMP_LESS_E);
+        if (ascending != (delta > 0)) return;
+
+        // body must not touch neither counter nor bound,
+        // calls are forbidden as callee can see loop scope
+        bool writes = false, calls = false;
+        scan_writes(&for_block, name, writes, calls);
+        if (!bound_name.empty()) scan_writes(&for_block, bound_name, writes, calls);
+        if (writes || calls) return;
+
+        counter = decl->getSymbol();
+        bound = &compare->right();
+        step = delta;
+        shape = SHAPE_COUNTED;
+    }
+
+    bool For::eval_counted(MemoryKernel& mem) {
+        MemObject* obj = mem.get_object(counter);
+        if (!obj || obj->get_type() != OBJECT_NUMBER) return false;
+
+        long long start, limit;
+        MemObject* bound_obj = bound->eval(mem);
+        if (!bound_obj || bound_obj->get_type() != OBJECT_NUMBER) return false;
+        if (!obj->get_integer(start) || !counter_limit(start)) return false;
+        if (!bound_obj->get_integer(limit) || !counter_limit(limit)) return false;
+
+        for (long long i = start;; i += step) {
+            bool go;
+            switch (cmp) {
+                case CMP_LESS: go = i < limit; break;
+                case CMP_LESS_E: go = i <= limit; break;
+                case CMP_GREATER: go = i > limit; break;
+                default: go = i >= limit; break;
+            }
+            if (!go) {
+                // counter is left at the first failing value,
+                // as generic `i += step` leaves it
+                if (i != start) obj->set_integer(i);
+                break;
+            }
+
+            // keep counter visible to body in the same format
+            // as generic `i += step` would produce
+            if (i != start) obj->set_integer(i);
+            for_block.eval(mem);
+        }
+
+        return true;
+    }
+
+    MemObject* For::eval(MemoryKernel& mem) {
+        mem.enter_scope();
+        for (ASTNode* node : nodes) node->eval(mem);
+
+        // workers do not write shared nodes, unknown loop is generic for them
+        if (shape == SHAPE_UNKNOWN && !MemoryKernel::in_worker()) analyze();
+
+        if (shape != SHAPE_COUNTED || !eval_counted(mem)) {
+            while (true) {
+                MemObject* res = cond.eval(mem);
+
+                if (res->get_type() == OBJECT_BOOL && res->get_value() == "false") break;
+                else if (res->get_type() == OBJECT_NUMBER && res->get_number() == 0) break;
+                else if (res->get_type() == OBJECT_NULL) break;
+                for_block.eval(mem);
+                iter.eval(mem);
+            }
+        }
+
+        mem.exit_scope();
+        return new MemObject(OBJECT_NULL, 0, "null");
+    }
+
+    /**
+     * Rewrites body and condition of While loop: pure invariant
+     * expressions become Hoisted, products of counter and
+     * invariant become Reduced
+     */
+    class LoopPass {
+        const While& loop;
+        // symbols written in loop and steps of counters
+        // (written only as `i += c`, `i -= c` or `i = i + c`)
+        std::unordered_set<Symbol> written;
+        std::unordered_map<Symbol, long long> steps;
+        std::unordered_set<Symbol> irregular;
+
+        /**
+         * Step of write to `target` or 0 if write is not
+         * a constant shift of the same variable
+         */
+        static long long write_step(ASTNode* node, Symbol target) {
+            ASTNode* value = nullptr;
+            std::string kind;
+            if (CompExp* comp = dynamic_cast<CompExp*>(node)) {
+                if (!dynamic_cast<Ident*>(&comp->getIdent())) return 0;
+                value = &comp->getValue();
+                kind = static_cast<LeafNode&>(comp->getOper()).getValue();
+            } else if (Assign* assign = dynamic_cast<Assign*>(node)) {
+                if (assign->isElement() || assign->isDeclaration()) return 0;
+                BinOp* shift = dynamic_cast<BinOp*>(&assign->getValue());
+                Ident* self = shift ? dynamic_cast<Ident*>(&shift->left()) : nullptr;
+                if (!self || self->getSymbol() != target) return 0;
+                value = &shift->right();
+                if (dynamic_cast<Plus*>(shift)) kind = "Plus";
+                else if (dynamic_cast<Minus*>(shift)) kind = "Minus";
+            }
+
+            NumberConst* shift_val = dynamic_cast<NumberConst*>(value);
+            long long delta;
+            if (!shift_val || !NumberFormat::parse_integer(shift_val->getValue(), delta) ||
+                !counter_limit(delta) || delta == 0) return 0;
+            if (kind == "Minus") return -delta;
+            return kind == "Plus" ? delta : 0;
+        }
+
+        bool leaf(ASTNode* node) {
+            std::vector<ASTNode*> children;
+            node->children(children);
+            return children.empty();
+        }
+
+        // expression has no side effects and gives the same value
+        // (of the same type) on every iteration
+        bool invariant(ASTNode* node) {
+            if (dynamic_cast<Ident*>(node))
+                return !written.count(static_cast<Ident*>(node)->getSymbol());
+            if (TupleEl* element = dynamic_cast<TupleEl*>(node))
+                return !written.count(element->getTuple());
+            if (dynamic_cast<Hoisted*>(node)) return true;
+
+            bool known = dynamic_cast<LeafNode*>(node) || dynamic_cast<NullConst*>(node) ||
+                         dynamic_cast<Plus*>(node) || dynamic_cast<Minus*>(node) ||
+                         dynamic_cast<Times*>(node) || dynamic_cast<Div*>(node) ||
+                         dynamic_cast<And*>(node) || dynamic_cast<Or*>(node) ||
+                         dynamic_cast<Not*>(node) || dynamic_cast<Compare*>(node) ||
+                         dynamic_cast<IsOp*>(node) || dynamic_cast<ArrayEl*>(node) ||
+                         dynamic_cast<Interpolation*>(node);
+            if (!known) return false;
+
+            std::vector<ASTNode*> children;
+            node->children(children);
+            for (ASTNode* child : children)
+                if (!invariant(child)) return false;
+            return true;
+        }
+
+        // step of counter referred by node (0 if node is not a counter)
+        long long counter_step(ASTNode& node) {
+            Ident* ident = dynamic_cast<Ident*>(&node);
+            if (!ident || irregular.count(ident->getSymbol())) return 0;
+            auto found = steps.find(ident->getSymbol());
+            return found == steps.end() ? 0 : found->second;
+        }
+
+        void rewrite(ASTNode** slot) {
+            ASTNode* node = *slot;
+            if (!leaf(node) && invariant(node)) {
+                *slot = new Hoisted(loop, hoisted++, *node);
+                return;
+            }
+            visit(node);
+
+            Times* product = dynamic_cast<Times*>(node);
+            if (!product) return;
+            if (long long step = counter_step(product->left())) {
+                if (invariant(&product->right()))
+                    *slot = new Reduced(loop, reduced++, *product, true, step);
+            } else if (long long step = counter_step(product->right())) {
+                if (invariant(&product->left()))
+                    *slot = new Reduced(loop, reduced++, *product, false, step);
+            }
+        }
+
+    public:
+        size_t hoisted = 0;
+        size_t reduced = 0;
+        bool calls = false;
+
+        explicit LoopPass(const While& loop) : loop{loop} {}
+
+        // collects writes and calls of subtree
+        void scan(ASTNode* node) {
+            if (dynamic_cast<FuncDecl*>(node)) return;
+            if (dynamic_cast<FuncCall*>(node)) calls = true;
+
+            if (Symbol target = written_symbol(node)) {
+                written.insert(target);
+                long long step = write_step(node, target);
+                auto found = steps.find(target);
+                if (!step || (found != steps.end() && found->second != step))
+                    irregular.insert(target);
+                else
+                    steps[target] = step;
+            }
+
+            std::vector<ASTNode*> children;
+            node->children(children);
+            for (ASTNode* child : children) scan(child);
+        }
+
+        // rewrites replaceable places of subtree
+        void visit(ASTNode* node) {
+            if (dynamic_cast<FuncDecl*>(node) || dynamic_cast<Hoisted*>(node) ||
+                dynamic_cast<Reduced*>(node)) return;
+
+            std::vector<ASTNode*> children;
+            node->children(children);
+            std::vector<ASTNode**> slots;
+            node->slots(slots);
+
+            std::unordered_set<ASTNode*> replaceable;
+            for (ASTNode** slot : slots) replaceable.insert(*slot);
+            for (ASTNode** slot : slots) rewrite(slot);
+            for (ASTNode* child : children)
+                if (!replaceable.count(child)) visit(child);
+        }
+    };
+
+    void While::analyze() {
+        shape = LOOP_PLAIN;
+
+        LoopPass pass(*this);
+        pass.scan(while_cond);
+        pass.scan(&while_block);
+        // callee may write any variable of loop
+        if (pass.calls) return;
+
+        pass.visit(this);
+        hoisted = pass.hoisted;
+        reduced = pass.reduced;
+        if (hoisted || reduced) shape = LOOP_OPTIMIZED;
+    }
+
+    MemObject* Hoisted::eval(MemoryKernel& mem) {
+        LoopFrame* frame = LoopFrame::find(&loop);
+        if (!frame) return expr.eval(mem);
+
+        // evaluated where it was used first, so errors come in the same order
+        MemObject*& value = frame->values[slot];
+        if (!value) value = expr.eval(mem);
+        return value;
+    }
+
+    MemObject* Reduced::eval(MemoryKernel& mem) {
+        LoopFrame* frame = LoopFrame::find(&loop);
+        if (!frame) return product.eval(mem);
+
+        // operands are evaluated in the same order as by Times
+        MemObject* left = product.left().eval(mem);
+        MemObject* right = product.right().eval(mem);
+        MemObject* counter_obj = counter_left ? left : right;
+        MemObject* factor_obj = counter_left ? right : left;
+
+        ReducedState& state = frame->products[slot];
+        long long i, k, r, moved;
+        if (counter_obj->get_type() != OBJECT_NUMBER || factor_obj->get_type() != OBJECT_NUMBER ||
+            !counter_obj->get_integer(i) || !factor_obj->get_integer(k)) {
+            state.known = false;
+            return times(left, right);
+        }
+
+        bool known = state.known && k == state.factor &&
+                     !__builtin_sub_overflow(i, state.counter, &moved);
+        if (known && moved == 0) {
+            r = state.value;
+        } else if (!known || moved != step ||
+                   __builtin_add_overflow(state.value, state.delta, &r)) {
+            // first product, jump of counter or overflow of sum
+            if (__builtin_mul_overflow(i, k, &r) ||
+                __builtin_mul_overflow(step, k, &state.delta)) {
+                state.known = false;
+                return times(left, right);
+            }
+        }
+
+        state.known = true;
+        state.counter = i;
+        state.factor = k;
+        state.value = r;
+        return new MemObject(0, r);
+    }
+
     MemObject* FuncDecl::eval(MemoryKernel& mem) {
         if (mem.is_inside_func()){
             std::cout << "Can not declare function inside function\n";
             exit(1);
         }
         
-        std::vector<std::string> args;
-        for (auto p: this->params)
-            args.push_back(p->eval(mem)->get_value());
-        
-        return new MemFunction("", &this->funcBody, args);
+        return new MemFunction(0, &this->funcBody, this->arg_names);
+    }
+
+    MemFunction* FuncCall::resolve(MemoryKernel& mem, BuiltinBlock*& native) {
+        unsigned long version = MemoryKernel::func_bindings_version();
+        bool worker = MemoryKernel::in_worker();
+        if (!worker && cached_func && cached_version == version) {
+            native = cached_native;
+            return cached_func;
+        }
+
+        MemObject *obj = ident.eval(mem);
+        Ident *named = dynamic_cast<Ident*>(&ident);
+        std::string name = named ? named->getValue() : std::string("?");
+
+        if (!obj) {
+            std::cout << "Invalid reference to '" << name
+                      << "': variable does not exist\n";
+            exit(1);
+        }
+        if (obj->get_type() != OBJECT_FUNC) {
+            std::cout << "Can not call '" << name << "'"
+                      << ": " << ObjectTypeStr(obj->get_type())
+                      << " is not a function\n";
+            exit(1);
+        }
+
+        MemFunction *func = static_cast<MemFunction*>(obj);
+        native = dynamic_cast<BuiltinBlock*>(
+            static_cast<Block*>(func->get_entry_point()));
+        if (native && !native->is_native()) native = nullptr;
+
+        if (!worker) {
+            cached_func = func;
+            cached_version = version;
+            cached_native = native;
+        }
+        return func;
+    }
+
+    /**
+     * Largest inlined expression (nodes of return value)
+     */
+    static const size_t INLINE_BUDGET = 16;
+
+    // call sites with inlining decided (decisions are made by main thread)
+    static std::vector<const FuncCall*> inline_sites;
+    static bool inline_stats = false;
+
+    // arguments of inlined call evaluated on this thread
+    static thread_local MemObject** inline_args = nullptr;
+
+    MemObject* InlineArg::eval(MemoryKernel& mem) {
+        return inline_args[pos];
+    }
+
+    static size_t tree_size(ASTNode* node) {
+        std::vector<ASTNode*> children;
+        node->children(children);
+        size_t size = 1;
+        for (ASTNode* child : children) size += tree_size(child);
+        return size;
+    }
+
+    // checks if subtree calls function `name`
+    static bool calls_name(ASTNode* node, Symbol name) {
+        if (FuncCall* call = dynamic_cast<FuncCall*>(node)) {
+            std::vector<ASTNode*> children;
+            call->children(children);
+            Ident* callee = dynamic_cast<Ident*>(children[0]);
+            if (callee && callee->getSymbol() == name) return true;
+        }
+
+        std::vector<ASTNode*> children;
+        node->children(children);
+        for (ASTNode* child : children)
+            if (calls_name(child, name)) return true;
+        return false;
+    }
+
+    /**
+     * Copy of expression with parameters replaced by InlineArg or
+     * nullptr if expression has node which can not be copied.
+     * Constants and names of outer variables are shared
+     */
+    static ASTNode* copy_inline(ASTNode* node, const std::vector<Symbol>& params) {
+        if (Ident* ident = dynamic_cast<Ident*>(node)) {
+            auto found = std::find(params.begin(), params.end(), ident->getSymbol());
+            if (found == params.end()) return node;
+            return new InlineArg(found - params.begin());
+        }
+        // tuple is looked up by name, so parameter can not be replaced
+        if (TupleEl* element = dynamic_cast<TupleEl*>(node)) {
+            bool param = std::find(params.begin(), params.end(), element->getTuple()) != params.end();
+            return param ? nullptr : node;
+        }
+        if (dynamic_cast<LeafNode*>(node) || dynamic_cast<NullConst*>(node)) return node;
+
+        if (Not* negation = dynamic_cast<Not*>(node)) {
+            std::vector<ASTNode*> children;
+            negation->children(children);
+            ASTNode* operand = copy_inline(children[0], params);
+            return operand ? new Not(*operand) : nullptr;
+        }
+
+        BinOp* op = dynamic_cast<BinOp*>(node);
+        if (!op) return nullptr;
+        ASTNode* left = copy_inline(&op->left(), params);
+        ASTNode* right = copy_inline(&op->right(), params);
+        if (!left || !right) return nullptr;
+
+        const std::type_info& kind = typeid(*op);
+        if (kind == typeid(Plus)) return new Plus(*left, *right);
+        if (kind == typeid(Minus)) return new Minus(*left, *right);
+        if (kind == typeid(Times)) return new Times(*left, *right);
+        if (kind == typeid(Div)) return new Div(*left, *right);
+        if (kind == typeid(And)) return new And(*left, *right);
+        if (kind == typeid(Or)) return new Or(*left, *right);
+        if (kind == typeid(Less)) return new Less(*left, *right);
+        if (kind == typeid(Less_E)) return new Less_E(*left, *right);
+        if (kind == typeid(Greater)) return new Greater(*left, *right);
+        if (kind == typeid(Greater_E)) return new Greater_E(*left, *right);
+        if (kind == typeid(Equals)) return new Equals(*left, *right);
+        if (kind == typeid(Not_Equals)) return new Not_Equals(*left, *right);
+        if (kind == typeid(IsOp)) return new IsOp(*left, *right);
+        if (kind == typeid(ArrayEl)) return new ArrayEl(*left, *right);
+        return nullptr;
+    }
+
+    void FuncCall::plan_inline(MemFunction& func) {
+        inlining = INLINE_NO;
+        Block* body = static_cast<Block*>(func.get_entry_point());
+        // builtins are not candidates (and are not reported)
+        if (dynamic_cast<BuiltinBlock*>(body)) return;
+        inline_sites.push_back(this);
+
+        // body must be `return <expr>;`
+        std::vector<ASTNode*> nodes = body->getNodes();
+        Return* ret = nodes.size() == 1 ? dynamic_cast<Return*>(nodes[0]) : nullptr;
+        std::vector<ASTNode*> value;
+        if (ret) ret->children(value);
+
+        const std::vector<Symbol>& args = func.get_arg_names();
+        Ident* named = dynamic_cast<Ident*>(&ident);
+        size_t size = ret ? tree_size(value[0]) : 0;
+        bool func_arg = false;
+        for (ASTNode* param : params)
+            if (dynamic_cast<FuncDecl*>(param)) func_arg = true;
+
+        if (func.is_writable()) {
+            inline_note = "not inlined: function is not bound with const";
+        } else if (!ret) {
+            inline_note = "not inlined: body is not a single return";
+        } else if (named && calls_name(value[0], named->getSymbol())) {
+            inline_note = "not inlined: recursive";
+        } else if (has_calls(value[0])) {
+            inline_note = "not inlined: body calls functions";
+        } else if (size > INLINE_BUDGET) {
+            inline_note = "not inlined: body has " + std::to_string(size) +
+                          " nodes, budget is " + std::to_string(INLINE_BUDGET);
+        } else if (params.size() != args.size() ||
+                   std::set<Symbol>(args.begin(), args.end()).size() != args.size()) {
+            // full call reports invalid arguments
+            inline_note = "not inlined: invalid arguments";
+        } else if (func_arg) {
+            inline_note = "not inlined: argument declares function";
+        } else if (!(inline_expr = copy_inline(value[0], args))) {
+            inline_note = "not inlined: unsupported expression in body";
+        } else {
+            inlining = INLINE_YES;
+            inline_entry = body;
+            inline_note = "inlined, " + std::to_string(size) + " nodes";
+        }
+    }
+
+    MemObject* FuncCall::eval_inline(MemoryKernel& mem) {
+        // arguments are evaluated in order before body, as by full call
+        const size_t SMALL = 8;
+        MemObject* small[SMALL];
+        std::vector<MemObject*> large;
+        MemObject** values = small;
+        if (params.size() > SMALL) {
+            large.resize(params.size());
+            values = large.data();
+        }
+        for (size_t i = 0; i < params.size(); ++i) values[i] = params[i]->eval(mem);
+
+        MemObject** outer = inline_args;
+        inline_args = values;
+        MemObject* result = inline_expr->eval(mem);
+        inline_args = outer;
+        return result;
+    }
+
+    void FuncCall::prepare(MemoryKernel& mem) {
+        if (inlining != INLINE_UNKNOWN) return;
+
+        // looked up without errors, call may be never reached
+        Ident* named = dynamic_cast<Ident*>(&ident);
+        MemFunction* func = named ? dynamic_cast<MemFunction*>(mem.get_object(named->getSymbol()))
+                                  : nullptr;
+        if (func) plan_inline(*func);
+    }
+
+    void FuncCall::inline_report(std::ostream& out) const {
+        Ident* named = dynamic_cast<Ident*>(&ident);
+        out << "line " << line << ": " << (named ? named->getValue() : std::string("?"))
+            << ": " << inline_note << " (" << inlined_calls.load() << " inlined, "
+            << full_calls.load() << " full calls)\n";
+    }
+
+    void enable_inline_stats() { inline_stats = true; }
+
+    void report_inlining(std::ostream& out) {
+        if (!inline_stats) return;
+        std::cout.flush();
+
+        std::vector<const FuncCall*> sites = inline_sites;
+        std::stable_sort(sites.begin(), sites.end(), [](const FuncCall* a, const FuncCall* b) {
+            return a->get_line() < b->get_line();
+        });
+        for (const FuncCall* site : sites) site->inline_report(out);
     }
 
     MemObject* FuncCall::eval(MemoryKernel& mem) {
         
-        MemObject *obj = ident.eval(mem);
-        MemFunction *func = dynamic_cast<MemFunction*>(obj);
+        BuiltinBlock *native;
+        MemFunction *func = resolve(mem, native);
+
+        if (native) {
+            if (!native->accepts(params.size())) {
+                std::cout << func->get_name() << ": Invalid arguments. Aborting.\n";
+                exit(1);
+            }
+
+            // arguments are passed as evaluated, without memory traffic
+            // (on stack for usual small number of arguments)
+            const size_t SMALL = 8;
+            MemObject* small[SMALL];
+            std::vector<MemObject*> large;
+            MemObject** values = small;
+            if (params.size() > SMALL) {
+                large.resize(params.size());
+                values = large.data();
+            }
+            for (size_t i = 0; i < params.size(); ++i) values[i] = params[i]->eval(mem);
+
+            return native->call(mem, BuiltinArgs(values, params.size()));
+        }
+
+        // workers do not write shared nodes, they inline only prepared calls
+        if (inlining == INLINE_UNKNOWN && !MemoryKernel::in_worker()) plan_inline(*func);
+        if (inlining == INLINE_YES && func->get_entry_point() == inline_entry) {
+            if (inline_stats) inlined_calls.fetch_add(1, std::memory_order_relaxed);
+            return eval_inline(mem);
+        }
+        if (inline_stats) full_calls.fetch_add(1, std::memory_order_relaxed);
 
         // mem.dump_mem();
         mem.enter_scope();
         mem.mark_inside_func();
 
         std::vector<MemObject*> to_call;
-        std::vector<std::string> arg_names = func->get_arg_names();
+        const std::vector<Symbol>& arg_names = func->get_arg_names();
 
         // This should be modified when arrays are implemented
         if (params.size() != arg_names.size()) {
@@ -637,13 +1515,8 @@ namespace AST {
             ASTNode *node = params[i];
             MemObject* eval_res = node->eval(mem);
 
-            MemFunction *eval_res_f = dynamic_cast<MemFunction*>(eval_res);
-            if (eval_res_f) {
-                MemFunction *func_copy = new MemFunction(arg_names[i], eval_res_f->get_entry_point(), eval_res_f->get_arg_names());
-                to_call.push_back(func_copy);
-            } else {
-                to_call.push_back(new MemObject(eval_res->get_type(), arg_names[i], eval_res->get_value()));
-            }
+            // arrays and tuples are passed by shared storage (copy-on-write)
+            to_call.push_back(eval_res->copy_as(arg_names[i]));
         }
 
         if (!func->prep_mem(mem, to_call)) {
@@ -653,8 +1526,9 @@ namespace AST {
 
         static_cast<Block*>(func->get_entry_point())->eval(mem);
 
-        MemObject *ret = mem.get_object("$ret");
-        mem.drop_object("$ret");
+        static const Symbol ret_name = intern("$ret");
+        MemObject *ret = mem.get_object(ret_name);
+        mem.drop_object(ret_name);
 
         mem.exit_scope();
         mem.unmark_inside_func();
@@ -663,46 +1537,225 @@ namespace AST {
     }
 
     MemObject* Return::eval(MemoryKernel& mem) {
-        MemObject *_eval = this->expr.eval(mem);
-        mem.put_global(new MemObject(_eval->get_type(), "$ret", _eval->get_value()));
-        return new MemObject(OBJECT_NULL, "", "null");
+        MemObject *_eval = this->expr->eval(mem);
+        static const Symbol ret_name = intern("$ret");
+        mem.put_global(_eval->copy_as(ret_name));
+        return new MemObject(OBJECT_NULL, 0, "null");
+    }
+
+    std::string ArrayEl::index_text(const MemObject* index) {
+        long long value;
+        if (index->get_type() == OBJECT_NUMBER && index->get_integer(value))
+            return std::to_string(value);
+        return index->get_value();
+    }
+
+    Symbol ArrayEl::index_key(const MemObject* index, bool create) {
+        long long value;
+        if (index->get_type() == OBJECT_NUMBER && index->get_integer(value) &&
+            value >= 0 && (create || value < 4096))
+            return index_symbol(value);
+
+        std::string text = index_text(index);
+        if (create) return intern(text);
+        Symbol symbol;
+        return SymbolTable::global().lookup(text, symbol) ? symbol : 0;
     }
 
     MemObject* ArrayEl::eval(MemoryKernel& mem){
-        std::string name = left_.eval(mem)->get_name() + "@" + right_.eval(mem)->get_value();
-        return mem.get_object(name);
+        MemObject* container = left_->eval(mem);
+        if (MemDict* dict = dynamic_cast<MemDict*>(container)) {
+            MemObject* value = key ? dict->entries().get(symbol_name(key))
+                                   : dict->entries().get(index_text(right_->eval(mem)));
+            if (!value) return new MemObject(OBJECT_NULL, 0, "null");
+            return value;
+        }
+
+        MemArray* arr = dynamic_cast<MemArray*>(container);
+        if (!arr) return new MemObject(OBJECT_NULL, 0, "null");
+        const ArrayData& elems = arr->elements();
+
+        long pos;
+        long long value;
+        if (key) {
+            pos = elems.shape()->offset(key);
+        } else {
+            MemObject* index = right_->eval(mem);
+            // index keys are offsets, no key has to be interned
+            if (elems.shape()->implicit_keys() && index->get_type() == OBJECT_NUMBER &&
+                index->get_integer(value)) {
+                pos = value >= 0 && value < (long long)elems.size() ? value : -1;
+            } else {
+                Symbol key = index_key(index, false);
+                pos = key ? elems.shape()->offset(key) : -1;
+            }
+        }
+        if (pos < 0) return new MemObject(OBJECT_NULL, 0, "null");
+
+        // typed buffer is read without creating element objects
+        // (e.g. for mapped files)
+        if (elems.is_typed() && !elems.has_elements())
+            return new MemObject(0, elems.number_data()[pos]);
+        return elems.at(pos);
     }
 
     MemObject* ArrayDecl::eval(MemoryKernel& mem){
+        std::vector<MemObject*> values;
+        values.reserve(params.size());
         for (int i = 0; i < params.size(); i++)
         {
             MemObject* item = params[i]->eval(mem);
-            std::string name = "_garr@" + std::to_string(i);
-            mem.put_object(new MemObject(item->get_type(), name, item->get_value()));
+            values.push_back(item->copy_as(shape->key_at(i)));
         }
-        return new MemObject(OBJECT_ARRAY, "", std::to_string(params.size()));
+        return new MemArray(0, std::make_shared<ArrayData>(shape, values));
     }
 
     MemObject* TupleEl::eval(MemoryKernel& mem){
-        std::string name;
-        if(right_.eval(mem)->get_type() == OBJECT_NUMBER){
-            std::vector<MemObject *> elems = mem.extract_array(left_.eval(mem)->get_value());
-            int index = std::stoi(right_.eval(mem)->get_value());
-            return elems[index - 1];
-        }else{
-            name = left_.eval(mem)->get_value() + "@" + right_.eval(mem)->get_value();
-            return mem.get_object(name);
+        MemObject* tuple = mem.get_object(this->tuple);
+        if (!tuple || tuple->get_type() != OBJECT_ARRAY) return nullptr;
+        const ArrayData& elems = static_cast<MemArray*>(tuple)->elements();
+
+        // same shape - same offset
+        if (elems.shape() == cached_shape) return elems.at(cached_offset);
+
+        long pos;
+        if (!field) {
+            pos = std::stol(right_->eval(mem)->get_value()) - 1;
+            if (pos < 0 || pos >= (long)elems.size()) return nullptr;
+        } else {
+            pos = elems.shape()->offset(field);
+            if (pos < 0) return nullptr;
+        }
+
+        // private shapes may change or die, only shared ones are cached
+        // (not by workers of parallel builtins, node is shared by them)
+        if (elems.shape()->is_shared() && !MemoryKernel::in_worker()) {
+            cached_shape = elems.shape();
+            cached_offset = pos;
         }
+        return elems.at(pos);
+    }
+
+    Symbol TupleEl::element_key(MemoryKernel& mem){
+        if (field) return field;
+
+        std::string index_text = right_->eval(mem)->get_value();
+        MemArray* arr = mem.get_array(tuple);
+        int index = std::stoi(index_text);
+        if (arr && index >= 1 && index <= arr->elements().size())
+            return arr->elements().key_at(index - 1);
+        return intern(index_text);
     }
 
     MemObject* TupleDecl::eval(MemoryKernel& mem){
+        std::vector<MemObject*> values(shape->size(), nullptr);
         for (int i = 0; i < params.size(); i++)
         {
             Assign* tupleElem = dynamic_cast<Assign*>(params[i]);
-            tupleElem->setName("_garr@" + tupleElem->getName());
-            params[i]->eval(mem);
+            MemObject* item = tupleElem->getValue().eval(mem);
+            long pos = shape->offset(tupleElem->getSymbol());
+            delete values[pos];
+            values[pos] = item->copy_as(tupleElem->getSymbol());
+        }
+        return new MemArray(0, std::make_shared<ArrayData>(shape, values));
+    }
+
+    MemObject* DictDecl::eval(MemoryKernel& mem){
+        std::shared_ptr<DictData> entries = std::make_shared<DictData>();
+        for (auto &entry : params) {
+            std::string key = ArrayEl::index_text(entry.first->eval(mem));
+            entries->set(key, entry.second->eval(mem)->copy_as(0));
+        }
+        return new MemDict(0, entries);
+    }
+
+    /**
+     * Collects declarations (var/const assignments and function
+     * parameters) and names which are read somewhere in subtree
+     */
+    static void collect_names(ASTNode* node, std::vector<std::pair<const void*, Symbol>>& decls,
+                              std::unordered_set<Symbol>& reads) {
+        if (Ident* ident = dynamic_cast<Ident*>(node)) {
+            reads.insert(ident->getSymbol());
+        } else if (TupleEl* element = dynamic_cast<TupleEl*>(node)) {
+            reads.insert(element->getTuple());
+        } else if (Assign* assign = dynamic_cast<Assign*>(node)) {
+            if (assign->isDeclaration() && !assign->isElement())
+                decls.push_back({assign, assign->getSymbol()});
+        } else if (FuncDecl* func = dynamic_cast<FuncDecl*>(node)) {
+            // each parameter is a separate declaration site
+            const std::vector<Symbol>& args = func->getArgNames();
+            for (const Symbol& arg : args) decls.push_back({&arg, arg});
+        }
+
+        std::vector<ASTNode*> children;
+        node->children(children);
+
+        // tuple fields are not variables, only their values are visited
+        if (dynamic_cast<TupleDecl*>(node)) {
+            std::vector<ASTNode*> values;
+            for (ASTNode* field : children) field->children(values);
+            children.swap(values);
+        }
+
+        for (ASTNode* child : children) collect_names(child, decls, reads);
+    }
+
+    void report_unused(ASTNode* root) {
+        if (!Diagnostics::enabled() || !root) return;
+
+        std::vector<std::pair<const void*, Symbol>> decls;
+        std::unordered_set<Symbol> reads;
+        collect_names(root, decls, reads);
+
+        for (auto& decl : decls) {
+            if (reads.count(decl.second) || symbol_name(decl.second)[0] == '_') continue;
+            Diagnostics::unused_variable(decl.first, decl.second);
         }
-        return new MemObject(OBJECT_ARRAY, "", std::to_string(params.size()));
+        Diagnostics::mark_analysed();
+    }
+
+    /**
+     * Walks body of function called in parallel (`params` are its
+     * parameters) and bodies of script functions it refers to
+     */
+    static void prepare_body(MemoryKernel& mem, ASTNode* node, const std::vector<Symbol>& params,
+                             std::unordered_set<void*>& visited, const char* name) {
+        if (Assign* assign = dynamic_cast<Assign*>(node)) assign->prepare();
+        if (For* loop = dynamic_cast<For*>(node)) loop->prepare();
+        if (While* loop = dynamic_cast<While*>(node)) loop->prepare();
+        if (FuncCall* call = dynamic_cast<FuncCall*>(node)) call->prepare(mem);
+
+        // parameters shadow outer variables, everything else is
+        // looked up in outer scopes, where it is read-only
+        Symbol target = written_symbol(node);
+        if (target && std::find(params.begin(), params.end(), target) == params.end() &&
+            mem.get_object(target)) {
+            std::cout << name << ": callback writes to outer variable '"
+                      << symbol_name(target) << "'. Aborting.\n";
+            exit(1);
+        }
+
+        // functions referred by name (called or passed further)
+        if (Ident* ident = dynamic_cast<Ident*>(node)) {
+            MemFunction* func = dynamic_cast<MemFunction*>(mem.get_object(ident->getSymbol()));
+            void* entry = func ? func->get_entry_point() : nullptr;
+            if (entry && !dynamic_cast<BuiltinBlock*>(static_cast<Block*>(entry)) &&
+                visited.insert(entry).second)
+                prepare_body(mem, static_cast<Block*>(entry), func->get_arg_names(), visited, name);
+        }
+
+        std::vector<ASTNode*> children;
+        node->children(children);
+        for (ASTNode* child : children) prepare_body(mem, child, params, visited, name);
+    }
+
+    void prepare_parallel(MemoryKernel& mem, MemFunction& func, const char* name) {
+        void* entry = func.get_entry_point();
+        if (dynamic_cast<BuiltinBlock*>(static_cast<Block*>(entry))) return;
+
+        std::unordered_set<void*> visited{entry};
+        prepare_body(mem, static_cast<Block*>(entry), func.get_arg_names(), visited, name);
     }
 
     void ASTNode::json_indent(std::ostream& out, AST_print_context& ctx) {
@@ -750,14 +1803,14 @@ namespace AST {
     void Assign::json(std::ostream& out, AST_print_context& ctx) {
         json_head("Assign", out, ctx);
         json_child("mod", mod, out, ctx);
-        out << "\"name\" : \"" << name << "\"";
-        json_child("value", value, out, ctx, ' ');
+        out << "\"name\" : \"" << getName() << "\"";
+        json_child("value", *value, out, ctx, ' ');
         json_close(out, ctx);
     }
 
     void If::json(std::ostream& out, AST_print_context& ctx) {
         json_head("If", out, ctx);
-        json_child("condition", cond, out, ctx);
+        json_child("condition", *cond, out, ctx);
         json_child("true_block", true_block, out, ctx);
         json_child("else_block", else_block, out, ctx, ' ');
         json_close(out, ctx);
@@ -765,11 +1818,26 @@ namespace AST {
 
     void While::json(std::ostream& out, AST_print_context& ctx) {
         json_head("While", out, ctx);
-        json_child("while_condition", while_cond, out, ctx);
+        json_child("while_condition", *while_cond, out, ctx);
         json_child("while_block", while_block, out, ctx);
         json_close(out, ctx);
     }
 
+    // loop rewrites are not part of the program text
+    void InlineArg::json(std::ostream& out, AST_print_context& ctx) {
+        json_head("InlineArg", out, ctx);
+        out << "\"position\" : " << pos;
+        json_close(out, ctx);
+    }
+
+    void Hoisted::json(std::ostream& out, AST_print_context& ctx) {
+        expr.json(out, ctx);
+    }
+
+    void Reduced::json(std::ostream& out, AST_print_context& ctx) {
+        product.json(out, ctx);
+    }
+
     void For::json(std::ostream& out, AST_print_context& ctx) {
         json_head("For", out, ctx);
         out << "\"assigns\" : [";
@@ -779,7 +1847,7 @@ namespace AST {
             stmt->json(out, ctx);
             sep = ", ";
         }
-        out << "]";
+        out << "],";
         json_child("conditions", cond, out, ctx);
         json_child("iterations", iter, out, ctx);
         json_child("for_block", for_block, out, ctx);
@@ -824,14 +1892,14 @@ namespace AST {
 
     void Return::json(std::ostream& out, AST_print_context& ctx) {
         json_head("Return", out, ctx);
-        json_child("return expr", expr, out, ctx);
+        json_child("return expr", *expr, out, ctx);
         json_close(out, ctx);   
     }
 
     void Read::json(std::ostream& out, AST_print_context& ctx) {
         json_head("Read", out, ctx);
         json_child("VarType", type, out, ctx);
-        out << "\"name\" : \"" << name << "\"";
+        out << "\"name\" : \"" << getName() << "\"";
         json_close(out, ctx);
     }
 
@@ -861,15 +1929,31 @@ namespace AST {
         json_close(out, ctx);
     }
 
+    void DictDecl::json(std::ostream& out, AST_print_context& ctx) {
+        json_head("Dict Decl", out, ctx);
+        out << "\"dict params\" : [";
+        auto sep = "";
+        for (auto &entry : params) {
+            out << sep << "[";
+            entry.first->json(out, ctx);
+            out << ", ";
+            entry.second->json(out, ctx);
+            out << "]";
+            sep = ", ";
+        }
+        out << "]";
+        json_close(out, ctx);
+    }
+
     void Not::json(std::ostream& out, AST_print_context& ctx) {
         json_head("Not", out, ctx);
-        json_child("left", left, out, ctx);
+        json_child("left", *left, out, ctx);
         json_close(out, ctx);
     }
 
     void Print::json(std::ostream& out, AST_print_context& ctx) {
         json_head("Print", out, ctx);
-        json_child("left", left, out, ctx);
+        json_child("left", *left, out, ctx);
         json_close(out, ctx);
     }
 
@@ -881,7 +1965,22 @@ namespace AST {
 
     void LeafNode::json(std::ostream& out, AST_print_context& ctx) {
         json_head(leaf_type, out, ctx);
-        out << "\"value\" : \"" << value << "\"";
+        out << "\"value\" : " << JsonWriter::quote(value);
+        json_close(out, ctx);
+    }
+
+    void Interpolation::json(std::ostream& out, AST_print_context& ctx) {
+        json_head("Interpolation", out, ctx);
+        out << "\"parts\" : [";
+        for (size_t i = 0; i < texts.size(); i++) {
+            out << JsonWriter::quote(texts[i]);
+            if (i < exprs.size()) {
+                out << ", ";
+                exprs[i]->json(out, ctx);
+                out << ", ";
+            }
+        }
+        out << "]";
         json_close(out, ctx);
     }
 
@@ -893,8 +1992,8 @@ namespace AST {
 
     void BinOp::json(std::ostream& out, AST_print_context& ctx) {
         json_head(opsym, out, ctx);
-        json_child("left", left_, out, ctx);
-        json_child("right", right_, out, ctx, ' ');
+        json_child("left", *left_, out, ctx);
+        json_child("right", *right_, out, ctx, ' ');
         json_close(out, ctx);
     }
 
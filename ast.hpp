@@ -5,9 +5,12 @@
 #include <vector>
 #include <iostream>
 #include <assert.h>
+#include <atomic>
 #include <stdio.h>
 #include "MemoryKernel.hpp"
 
+class BuiltinBlock;
+
 namespace AST {
     class AST_print_context {
     public:
@@ -28,6 +31,16 @@ namespace AST {
     public:
         virtual void json(std::ostream& out, AST_print_context& mem) = 0;
         virtual MemObject* eval(MemoryKernel& mem);
+        /**
+         * Перечисляет прямых потомков ноды
+         * (нужно для статического анализа дерева, например для For)
+        */
+        virtual void children(std::vector<ASTNode*>& out) {}
+        /**
+         * Перечисляет места прямых потомков-выражений, которые
+         * оптимизации могут заменить другим узлом (см. While::analyze)
+        */
+        virtual void slots(std::vector<ASTNode**>& out) {}
         std::string str() {
             std::stringstream ss;
             AST_print_context mem;
@@ -49,8 +62,9 @@ namespace AST {
      * Реалньо null
     */
     class NullConst : public ASTNode {
+        MemObject *constant;
     public:
-        explicit NullConst() {}
+        explicit NullConst() : constant{ConstantPool::get(OBJECT_NULL, "null")} {}
         void json(std::ostream& out, AST_print_context& mem) override;
         MemObject* eval(MemoryKernel& mem) override;
     };
@@ -73,18 +87,22 @@ namespace AST {
         LeafNode(std::string l_t, std::string v) :
                 leaf_type{l_t}, value{v} {};
     public:
+        const std::string& getValue() const { return value; }
         void json(std::ostream& out, AST_print_context& mem) override;
     };
 
     /**
      * Число
      * 
-     * Хранится в виде строки
+     * Хранится в виде строки, значение (уже разобранное число)
+     * берется из пула констант при построении дерева
     */
     class NumberConst : public LeafNode {
+        MemObject *constant;
     public:
         NumberConst(std::string v) : 
-            LeafNode(std::string("Number"), v) {};  
+            LeafNode(std::string("Number"), v),
+            constant{ConstantPool::get(OBJECT_NUMBER, v)} {};  
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -92,9 +110,39 @@ namespace AST {
      * Строка
     */
     class StringConst : public LeafNode {
+        MemObject *constant;
     public:
         StringConst(std::string v) :
-            LeafNode(std::string("String"), v) {};
+            LeafNode(std::string("String"), v),
+            constant{ConstantPool::get(OBJECT_STRING, v)} {};
+        MemObject* eval(MemoryKernel& mem) override;
+    };
+
+    /**
+     * Строка со встроенными выражениями
+     * 
+     * Пример "[{i}] {val}"
+     * Хранит куски текста и выражения между ними (текстов всегда на
+     * один больше). Каждое выражение вычисляется один раз, результат
+     * собирается в буфер нужного размера за одно выделение памяти
+    */
+    class Interpolation : public ASTNode {
+        std::vector<std::string> texts;
+        std::vector<ASTNode*> exprs;
+    public:
+        Interpolation() : texts(1) {}
+        void append_text(const std::string& text) { texts.back() += text; }
+        void append_expr(ASTNode &expr) {
+            exprs.push_back(&expr);
+            texts.emplace_back();
+        }
+        void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.insert(out.end(), exprs.begin(), exprs.end());
+        }
+        void slots(std::vector<ASTNode**>& out) override {
+            for (auto &expr : exprs) out.push_back(&expr);
+        }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -104,9 +152,11 @@ namespace AST {
      * Хранится в виде строки
     */
     class BoolConst : public LeafNode {
+        MemObject *constant;
     public:
         BoolConst(std::string v) :
-            LeafNode(std::string("Bool"), v) {};
+            LeafNode(std::string("Bool"), v),
+            constant{ConstantPool::get(OBJECT_BOOL, v)} {};
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -114,9 +164,11 @@ namespace AST {
      * Идентификатор (название переменной)
     */
     class Ident : public LeafNode {
+        Symbol symbol;
     public:
-        explicit Ident(std::string txt) :
-            LeafNode(std::string("Ident"), txt) {};
+        explicit Ident(Symbol name) :
+            LeafNode(std::string("Ident"), symbol_name(name)), symbol{name} {};
+        Symbol getSymbol() const { return symbol; }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -165,24 +217,60 @@ namespace AST {
      * value: значение переменной (Expression / Function Declaration)
      * 
      * имеет сеттер для mod
+     * 
+     * Присваивание вида s = s + a + b, где s - строка, дописывает
+     * a и b в буфер s на месте, без копирования всей строки
+     * 
+     * Для элемента (arr[1] = ..., t.a = ...) хранятся символы массива
+     * и ключа, name тогда имеет вид ИМЯ@КЛЮЧ. Если индекс - выражение
+     * (arr[i + 1] = ...), ключ вычисляется при каждом присваивании
     */
     class Assign : public ASTNode {
         AssignMod &mod;
-        std::string name;
-        ASTNode &value;
+        Symbol name;
+        Symbol array;
+        Symbol key;
+        // выражение индекса, если ключ не известен заранее
+        ASTNode *index;
+        ASTNode *value;
+
+        // для s = s + a + ...: слагаемые, дописываемые к строке s на месте
+        enum { APPEND_UNKNOWN, APPEND_YES, APPEND_NO } append;
+        std::vector<ASTNode*> append_parts;
+
+        void analyze();
     public:
-        Assign(AssignMod &mod, std::string lexpr, ASTNode &rexpr) :
-           mod{mod}, name{lexpr}, value{rexpr} {};
+        Assign(AssignMod &mod, Symbol lexpr, ASTNode &rexpr) :
+           mod{mod}, name{lexpr}, array{0}, key{0}, index{nullptr}, value{&rexpr},
+           append{APPEND_UNKNOWN} {};
+        Assign(AssignMod &mod, Symbol arr, Symbol elem_key, ASTNode &rexpr) :
+           mod{mod}, name{intern(symbol_name(arr) + "@" + symbol_name(elem_key))},
+           array{arr}, key{elem_key}, index{nullptr}, value{&rexpr}, append{APPEND_UNKNOWN} {};
+        // arr[index] = rexpr, числовой литерал в индексе дает ключ сразу
+        Assign(AssignMod &mod, Symbol arr, ASTNode &elem_index, ASTNode &rexpr);
         void set(AssignMod& mod_) {
             mod.setMod(mod_.getMod());
         }
-        void setName(std::string new_name){
-            name = new_name;
-        }
-        std::string getName(){
-           return name;
+        const std::string& getName(){
+           return symbol_name(name);
         }
+        Symbol getSymbol() const { return name; }
+        bool isElement() const { return array != 0; }
+        bool isDeclaration() { return mod.getMod() != "assign"; }
+        // символ, который меняет присваивание (для элемента - массив)
+        Symbol getTarget() const { return isElement() ? array : name; }
+        ASTNode& getValue() { return *value; }
+        // разбор формы присваивания заранее (см. prepare_parallel)
+        void prepare() { if (append == APPEND_UNKNOWN) analyze(); }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            if (index) out.push_back(index);
+            out.push_back(value);
+        }
+        void slots(std::vector<ASTNode**>& out) override {
+            if (index) out.push_back(&index);
+            out.push_back(&value);
+        }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -233,6 +321,9 @@ namespace AST {
         void append(ASTNode* node) { nodes.push_back(node); }
         std::vector<ASTNode*> getNodes() { return nodes; }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.insert(out.end(), nodes.begin(), nodes.end());
+        }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -244,13 +335,19 @@ namespace AST {
      * else_block: блок, когда выражение - ложь
     */
     class If : public ASTNode {
-        ASTNode &cond;
+        ASTNode *cond;
         Block &true_block; 
         Block &else_block;
     public:
         explicit If(ASTNode &cond, Block &ifpart, Block &elsepart) :
-            cond{cond}, true_block{ifpart}, else_block{elsepart} { };
+            cond{&cond}, true_block{ifpart}, else_block{elsepart} { };
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.push_back(cond);
+            out.push_back(&true_block);
+            out.push_back(&else_block);
+        }
+        void slots(std::vector<ASTNode**>& out) override { out.push_back(&cond); }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -258,10 +355,12 @@ namespace AST {
      * Принтуем какое-то выражение
     */
     class Print : public ASTNode {
-        ASTNode& left;
+        ASTNode *left;
     public:
-        explicit Print(ASTNode &l) : left{l} {}
+        explicit Print(ASTNode &l) : left{&l} {}
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override { out.push_back(left); }
+        void slots(std::vector<ASTNode**>& out) override { out.push_back(&left); }
         MemObject* eval(MemoryKernel& mem) override;
     };
     // Bin Operations
@@ -277,12 +376,22 @@ namespace AST {
     class BinOp : public ASTNode {
     protected:
         std::string opsym;
-        ASTNode &left_;
-        ASTNode &right_;
+        ASTNode *left_;
+        ASTNode *right_;
         BinOp(std::string sym, ASTNode &l, ASTNode &r) :
-                opsym{sym}, left_{l}, right_{r} {};
+                opsym{sym}, left_{&l}, right_{&r} {};
     public:
+        ASTNode& left() { return *left_; }
+        ASTNode& right() { return *right_; }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.push_back(left_);
+            out.push_back(right_);
+        }
+        void slots(std::vector<ASTNode**>& out) override {
+            out.push_back(&left_);
+            out.push_back(&right_);
+        }
     };
 
     /**
@@ -295,11 +404,13 @@ namespace AST {
      * удобнее, в таком случае call me)
     */
     class Read : public ASTNode {
-        std::string name;
+        Symbol name;
         ASTNode &type;
     public:
-        Read(ASTNode &l, std::string n) :
+        Read(ASTNode &l, Symbol n) :
                 name{n}, type{l} {};
+        const std::string& getName() { return symbol_name(name); }
+        Symbol getSymbol() const { return name; }
         void json(std::ostream& out, AST_print_context& mem) override;
         MemObject* eval(MemoryKernel& mem) override;
     };
@@ -383,10 +494,12 @@ namespace AST {
      * Логическое Отрицание
     */
     class Not : public ASTNode {
-        ASTNode& left;
+        ASTNode *left;
     public:
-        explicit Not(ASTNode &l) : left{l} {}
+        explicit Not(ASTNode &l) : left{&l} {}
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override { out.push_back(left); }
+        void slots(std::vector<ASTNode**>& out) override { out.push_back(&left); }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -473,14 +586,89 @@ namespace AST {
      * 
      * while_cond: условие, при котором блок выполняется
      * while_block: блок вайла
+     *
+     * Если цикл (условие и тело) не вызывает функций, то при первом
+     * исполнении он оптимизируется:
+     * - чистые выражения над переменными, которые в цикле не пишутся
+     *   (t.a * 2, c + 1, "x" + prefix), заменяются узлом Hoisted и
+     *   вычисляются один раз за проход цикла
+     * - произведение i * k, где i меняется только как i += шаг,
+     *   а k - инвариант, заменяется узлом Reduced (сложение вместо
+     *   умножения)
+     * Тип переменной меняется только записью, а записанные в цикле
+     * переменные инвариантами не считаются, поэтому смена типа
+     * значения (var x = 1; ... x = "a") оптимизацию не ломает
     */
     class While : public ASTNode {
-        ASTNode &while_cond;
+        ASTNode *while_cond;
         Block &while_block;
+
+        // результат разбора цикла (делается один раз, лениво)
+        enum { LOOP_UNKNOWN, LOOP_PLAIN, LOOP_OPTIMIZED } shape;
+        // число узлов Hoisted и Reduced этого цикла
+        size_t hoisted;
+        size_t reduced;
+
+        void analyze();
     public:
         explicit While(ASTNode &cond, Block &body) :
-            while_cond{cond}, while_block{body} {};
+            while_cond{&cond}, while_block{body}, shape{LOOP_UNKNOWN},
+            hoisted{0}, reduced{0} {};
+        // разбор цикла заранее (см. prepare_parallel)
+        void prepare() { if (shape == LOOP_UNKNOWN) analyze(); }
+        void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.push_back(while_cond);
+            out.push_back(&while_block);
+        }
+        void slots(std::vector<ASTNode**>& out) override { out.push_back(&while_cond); }
+        MemObject* eval(MemoryKernel& mem) override;
+    };
+
+    /**
+     * Инвариант цикла While
+     *
+     * Выражение вычисляется на своем месте при первом обращении за
+     * проход цикла (ошибки и порядок вычисления те же), дальше
+     * значение берется из кадра цикла. Кадр свой у каждого прохода
+     * и у каждого потока
+    */
+    class Hoisted : public ASTNode {
+        const While &loop;
+        size_t slot;
+        ASTNode &expr;
+    public:
+        Hoisted(const While &loop, size_t slot, ASTNode &expr) :
+            loop{loop}, slot{slot}, expr{expr} {};
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override { out.push_back(&expr); }
+        MemObject* eval(MemoryKernel& mem) override;
+    };
+
+    /**
+     * Произведение i * k в цикле While, где i меняется только
+     * как i += step, а k - инвариант
+     *
+     * Пока i и k - целые, следующее значение получается из
+     * предыдущего сложением с step * k (если i сдвинулся ровно
+     * на step) или берется как есть (если i не менялся). Иначе
+     * (дробные числа, смена типа, переполнение) вычисляется
+     * исходное произведение
+    */
+    class Reduced : public ASTNode {
+        const While &loop;
+        size_t slot;
+        BinOp &product;
+        // операнд i - левый операнд произведения
+        bool counter_left;
+        long long step;
+    public:
+        Reduced(const While &loop, size_t slot, BinOp &product, bool counter_left,
+                long long step) :
+            loop{loop}, slot{slot}, product{product}, counter_left{counter_left},
+            step{step} {};
+        void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override { out.push_back(&product); }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -489,42 +677,85 @@ namespace AST {
      * 
      * decl: создание переменных для цикла for
      * cond: условие, пока истина, цикл итерируется
-     * iter: ???? (CompExp) пока только ввиде ИДЕНТ (+, -, /, *)= ЗНАЧЕНИЕ
+     * iter: CompExp, пока только ввиде ИДЕНТ (+, -, /, *)= ЗНАЧЕНИЕ
      * for_block: block цикла
      * 
      * При создании задаем условие, операция итерации, блок
      * А создание переменных, через flat, как в случае с Block и assigns
+     *
+     * Если цикл "счетный" (for var i = 0; i < n; i += 1, где шаг - 
+     * целая константа, граница не меняется в теле, а тело не пишет
+     * в счетчик и не вызывает функций), то он исполняется на нативном
+     * целочисленном счетчике без вычисления cond/iter через MemObject
     */
     class For : public ASTNode {
         std::vector<ASTNode*> nodes;
         ASTNode &cond;
         ASTNode &iter;
         Block &for_block;
+
+        // результат разбора формы цикла (делается один раз, лениво)
+        enum { SHAPE_UNKNOWN, SHAPE_COUNTED, SHAPE_GENERIC } shape;
+        enum { CMP_LESS, CMP_LESS_E, CMP_GREATER, CMP_GREATER_E } cmp;
+        Symbol counter;             // символ имени счетчика
+        ASTNode *bound;             // выражение границы (литерал или переменная)
+        long long step;             // шаг со знаком
+
+        void analyze();
+        bool eval_counted(MemoryKernel& mem);
     public:
         explicit For(ASTNode &c, ASTNode &i, Block &b) :
-            cond{c}, iter{i}, for_block{b} {};
+            cond{c}, iter{i}, for_block{b}, shape{SHAPE_UNKNOWN}, bound{nullptr}, step{0} {};
         void flat(Block* block) {
             for (auto &i : block->getNodes()) {
                 nodes.push_back(i);
             }
         }
+        // разбор формы цикла заранее (см. prepare_parallel)
+        void prepare() { if (shape == SHAPE_UNKNOWN) analyze(); }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.insert(out.end(), nodes.begin(), nodes.end());
+            out.push_back(&cond);
+            out.push_back(&iter);
+            out.push_back(&for_block);
+        }
+        MemObject* eval(MemoryKernel& mem) override;
     };
 
     /**
      * Computational Expression для Фора
      * 3 штука в создании фора, операция, которая выполняется при каждой итерации
      * 
-     * FIXME: меня не должно существовать 
+     * Также используется как отдельная операция: x += 1; t.a *= 2;
+     * (ИДЕНТ op= ЗНАЧЕНИЕ вычисляется как ИДЕНТ = ИДЕНТ op ЗНАЧЕНИЕ)
     */
     class CompExp: public ASTNode {
+        friend For;
         ASTNode &ident;
         ASTNode &oper;
         ASTNode &val;
+        // бинарная операция ident op val, собирается в конструкторе
+        ASTNode *op;
+        // val без вызовов функций (s += val можно дописать на месте)
+        bool pure_val;
     public:
-        explicit CompExp(ASTNode &i, ASTNode &o, ASTNode &v) :
-            ident{i}, oper{o}, val{v} {};
+        explicit CompExp(ASTNode &i, ASTNode &o, ASTNode &v);
+        ASTNode& getIdent() { return ident; }
+        ASTNode& getOper() { return oper; }
+        ASTNode& getValue() { return val; }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.push_back(&ident);
+            out.push_back(&val);
+        }
+        // место val в операции op (ident не заменяется)
+        void slots(std::vector<ASTNode**>& out) override {
+            std::vector<ASTNode**> op_slots;
+            op->slots(op_slots);
+            out.push_back(op_slots.back());
+        }
+        MemObject* eval(MemoryKernel& mem) override;
     };
 
     // Functions
@@ -540,6 +771,8 @@ namespace AST {
     class FuncDecl: public ASTNode {
         friend Assign;
         std::vector<ASTNode*> params;
+        // символы имен параметров
+        std::vector<Symbol> arg_names;
         Block &funcBody;
     public:
         explicit FuncDecl(Block &func_body) :
@@ -547,18 +780,23 @@ namespace AST {
         void flat(Block* block) {
             for (auto &i : block->getNodes()) {
                 params.push_back(i);
+                arg_names.push_back(intern(static_cast<LeafNode*>(i)->getValue()));
             }
         }
+        const std::vector<Symbol>& getArgNames() const { return arg_names; }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override { out.push_back(&funcBody); }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
     class Return: public ASTNode {
-        ASTNode &expr;
+        ASTNode *expr;
     public:
         explicit Return(ASTNode &func_expr) :
-            expr{func_expr} {};
+            expr{&func_expr} {};
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override { out.push_back(expr); }
+        void slots(std::vector<ASTNode**>& out) override { out.push_back(&expr); }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -567,18 +805,85 @@ namespace AST {
      * 
      * ident: имя вызываемой функции
      * params: вектор передаваемых выражений (переменная, мат. вычисление)
+     * 
+     * Найденная функция запоминается в месте вызова, повторный поиск
+     * по областям видимости нужен только после смены привязок функций
+     * 
+     * Нативные встроенные функции получают вычисленные аргументы
+     * напрямую, без области видимости и копий аргументов в памяти
+     * 
+     * В колбэках параллельных встроенных функций кэш не используется:
+     * у каждого потока свои привязки имен
+     * 
+     * Маленькая функция, привязанная через const, тело которой -
+     * один return без вызовов, подставляется в место вызова: копия
+     * выражения с аргументами InlineArg вычисляется без области
+     * видимости, копий аргументов и $ret. Аргументы вычисляются
+     * по порядку, как при обычном вызове. Подстановка действует,
+     * пока имя указывает на ту же функцию (иначе - обычный вызов)
     */
     class FuncCall: public ASTNode {
         ASTNode &ident;
         std::vector<ASTNode*> params;
+        // кэш вызываемой функции, валиден пока не изменилась
+        // версия привязок функций в памяти
+        MemFunction *cached_func;
+        unsigned long cached_version;
+        // тело найденной функции, если она нативная встроенная
+        BuiltinBlock *cached_native;
+
+        // строка вызова в тексте программы (для статистики подстановки)
+        size_t line;
+        // решение о подстановке (принимается при первом вызове)
+        enum { INLINE_UNKNOWN, INLINE_NO, INLINE_YES } inlining;
+        // подставленное выражение и тело функции, из которого оно взято
+        ASTNode *inline_expr;
+        void *inline_entry;
+        // причина решения и счетчики вызовов (см. report_inlining)
+        std::string inline_note;
+        std::atomic<unsigned long> inlined_calls;
+        std::atomic<unsigned long> full_calls;
+
+        MemFunction* resolve(MemoryKernel& mem, BuiltinBlock*& native);
+        void plan_inline(MemFunction& func);
+        MemObject* eval_inline(MemoryKernel& mem);
     public:
         explicit FuncCall(ASTNode &func_ident) :
-            ident(func_ident) {};
+            ident(func_ident), cached_func{nullptr}, cached_version{0},
+            cached_native{nullptr}, line{0}, inlining{INLINE_UNKNOWN},
+            inline_expr{nullptr}, inline_entry{nullptr}, inlined_calls{0},
+            full_calls{0} {};
         void flat(Block* block) {
             for (auto &i : block->getNodes()) {
                 params.push_back(i);
             }
         }
+        void set_line(size_t call_line) { line = call_line; }
+        size_t get_line() const { return line; }
+        // решение о подстановке заранее (см. prepare_parallel)
+        void prepare(MemoryKernel& mem);
+        // строка с решением о подстановке для статистики
+        void inline_report(std::ostream& out) const;
+        void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.push_back(&ident);
+            out.insert(out.end(), params.begin(), params.end());
+        }
+        void slots(std::vector<ASTNode**>& out) override {
+            for (auto &param : params) out.push_back(&param);
+        }
+        MemObject* eval(MemoryKernel& mem) override;
+    };
+
+
+    /**
+     * Аргумент подставленной функции (см. FuncCall): значение берется
+     * из аргументов, вычисленных в месте вызова
+    */
+    class InlineArg : public ASTNode {
+        size_t pos;
+    public:
+        explicit InlineArg(size_t pos) : pos{pos} {}
         void json(std::ostream& out, AST_print_context& mem) override;
         MemObject* eval(MemoryKernel& mem) override;
     };
@@ -590,13 +895,30 @@ namespace AST {
      * Оюращение к элементу массива
      * 
      * left: имя массива (Ident('arr'))
-     * right: индекс элемента (Number(15))
+     * right: индекс элемента (Number(15) либо выражение)
     */
     class ArrayEl : public BinOp {
+        // символ индекса, если он задан литералом
+        // (иначе ключ вычисляется по значению right)
+        Symbol key;
     public:
         ArrayEl(ASTNode &l, ASTNode &r) :
-                BinOp(std::string("ArrElem"),  l, r) {};
+                BinOp(std::string("ArrElem"),  l, r), key{0} {
+            if (NumberConst* leaf = dynamic_cast<NumberConst*>(&r)) key = intern(leaf->getValue());
+        };
         MemObject* eval(MemoryKernel& mem) override;
+
+        /**
+         * Ключ элемента по значению индекса: целое число дает
+         * запись без дробной части (как ключи литерала массива)
+         * 
+         * create: добавить ключ в таблицу символов, если его нет
+         * (иначе для неизвестного ключа возвращается 0)
+        */
+        static Symbol index_key(const MemObject* index, bool create);
+
+        // текст ключа по значению индекса (ключ словаря)
+        static std::string index_text(const MemObject* index);
     };
 
     /**
@@ -607,14 +929,24 @@ namespace AST {
     */
     class ArrayDecl : public ASTNode {
         std::vector<ASTNode*> params; 
+        // форма (ключи 0..n-1), общая для всех массивов из этого объявления
+        std::shared_ptr<Shape> shape;
     public:
         ArrayDecl() {}; 
         void flat(Block* block) {
             for (auto &i : block->getNodes()) {
                 params.push_back(i);
             }
+            shape = std::make_shared<Shape>(true);
+            for (int i = 0; i < params.size(); i++) shape->append(intern(std::to_string(i)));
         }
         void json(std::ostream& out, AST_print_context& mem) override;
+        void children(std::vector<ASTNode*>& out) override {
+            out.insert(out.end(), params.begin(), params.end());
+        }
+        void slots(std::vector<ASTNode**>& out) override {
+            for (auto &param : params) out.push_back(&param);
+        }
         MemObject* eval(MemoryKernel& mem) override;
     };
 
@@ -627,28 +959,116 @@ namespace AST {
      * right: имя элемента (Ident) либо через индекс (Number)
     */
     class TupleEl : public BinOp {
+        // символы имени тюпла и поля (поле 0 - обращение по индексу)
+        Symbol tuple;
+        Symbol field;
+        // мономорфный inline cache: форма тюпла и смещение поля в ней
+        const Shape *cached_shape;
+        long cached_offset;
     public:
         TupleEl(ASTNode &l, ASTNode &r) :
-                BinOp(std::string("TuplElem"),  l, r) {};
+                BinOp(std::string("TuplElem"),  l, r),
+                tuple{intern(static_cast<LeafNode&>(l).getValue())}, field{0},
+                cached_shape{nullptr}, cached_offset{0} {
+            if (dynamic_cast<StringConst*>(&r))
+                field = intern(static_cast<LeafNode&>(r).getValue());
+        };
         MemObject* eval(MemoryKernel& mem) override;
+        // операнды - имена, а не выражения
+        void slots(std::vector<ASTNode**>& out) override {}
+        Symbol getTuple() const { return tuple; }
+        /**
+         * Ключ элемента в памяти тюпла,
+         * обращение по индексу заменяется именем поля
+        */
+        Symbol element_key(MemoryKernel& mem);
     };
 
     /**
      * Объявление тюпла
      * { a=15, b=7, c='123', d=a(123) }
      * Хранит в себе вектор этих элементов тюпла
+     * 
+     * Все тюплы из одного объявления имеют одну и ту же форму (Shape)
     */
     class TupleDecl : public ASTNode {
         std::vector<ASTNode*> params;
+        std::shared_ptr<Shape> shape;
     public:
         TupleDecl() {};
         void flat(Block* block) {
             for (auto &i : block->getNodes()) {
                 params.push_back(i);
             }
+            shape = std::make_shared<Shape>(true);
+            for (int i = 0; i < params.size(); i++) {
+                Symbol field = dynamic_cast<Assign*>(params[i])->getSymbol();
+                if (shape->offset(field) < 0) shape->append(field);
+            }
         }
         void json(std::ostream& out, AST_print_context& mem) override; 
+        void children(std::vector<ASTNode*>& out) override {
+            out.insert(out.end(), params.begin(), params.end());
+        }
+        MemObject* eval(MemoryKernel& mem) override;
+    };
+
+    /**
+     * Объявление словаря
+     * 
+     * Пример { "a": 1, key: f(2) }
+     * Хранит пары (ключ, значение), ключом становится текст
+     * значения выражения ключа. Повторный ключ заменяет значение
+    */
+    class DictDecl : public ASTNode {
+        std::vector<std::pair<ASTNode*, ASTNode*>> params;
+    public:
+        DictDecl() {};
+        void append(ASTNode &key, ASTNode &value) {
+            params.push_back({&key, &value});
+        }
+        void json(std::ostream& out, AST_print_context& mem) override; 
+        void children(std::vector<ASTNode*>& out) override {
+            for (auto &entry : params) {
+                out.push_back(entry.first);
+                out.push_back(entry.second);
+            }
+        }
         MemObject* eval(MemoryKernel& mem) override;
     };
+
+    /**
+     * Статический поиск неиспользуемых переменных
+     * 
+     * Объявление (var/const, параметр функции), имя которого нигде
+     * в программе не читается, выдается как предупреждение (Diagnostics).
+     * Имена, начинающиеся с '_', не проверяются
+    */
+    void report_unused(ASTNode* root);
+
+    /**
+     * Подготовка функции к вызову из параллельных встроенных функций
+     * (par_map, par_for_each)
+     * 
+     * Обходит тело функции и тела функций, которые из него видны.
+     * Запись в переменную внешней области видимости (которая не
+     * является параметром функции) - ошибка: колбэк выполняется
+     * параллельно и видит внешние переменные только для чтения.
+     * Ленивые разборы узлов (циклы, присваивания) делаются заранее,
+     * потоки их не пишут
+     * 
+     * name: имя встроенной функции для сообщения об ошибке
+    */
+    void prepare_parallel(MemoryKernel& mem, MemFunction& func, const char* name);
+
+    /**
+     * Статистика подстановки функций (флаг --inline-stats)
+     * 
+     * Для каждого места вызова функции скрипта: подставлено ли тело
+     * и почему, сколько вызовов прошло подстановкой и сколько обычным
+     * вызовом. Места выводятся по порядку строк
+    */
+    void enable_inline_stats();
+    void report_inlining(std::ostream& out);
 }
-#endif /* AST_HPP */
\ No newline at end of file
+#endif /* AST_HPP */
@@ -1,9 +1,24 @@
 #include "builtin.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "MemoryKernel.hpp"
 #include "ast.hpp"
+#include "csv.hpp"
+#include "json.hpp"
+#include "numbers.hpp"
+#include "threadpool.hpp"
+#include "vecmath.hpp"
 
 using namespace std;
 
@@ -15,59 +30,1481 @@ class BuiltinTriplet {
 
   BuiltinTriplet(string name, BuiltinBlock* block, vector<string> args)
       : name(name), block(block), args(args) {}
+
+  // native builtin, arity is the number of `args`,
+  // last `optional` of them may be omitted in direct call
+  BuiltinTriplet(string name, builtin_native_t native, vector<string> args,
+                 size_t optional = 0)
+      : name(name), args(args) {
+    vector<Symbol> params;
+    for (auto& arg : args) params.push_back(intern(arg));
+    block = new BuiltinBlock(native, params, optional);
+  }
 };
 
 /**********************************************************************
  * Builtin functions implementation
  *********************************************************************/
 
-MemObject* builtin_dump_mem(MemoryKernel& mem) {
+MemObject* builtin_dump_mem(MemoryKernel& mem, BuiltinArgs args) {
   mem.dump_mem();
   return nullptr;
 }
 
-MemObject* builtin_for_each(MemoryKernel& mem) {
-  MemFunction* func =
-      dynamic_cast<MemFunction*>(mem.get_object("for_each_func"));
+/**********************************************************************
+ * Iteration protocol for higher-order builtins
+ *********************************************************************/
 
-  if (!func) return nullptr;
+// truth value of object, as `if` and `while` treat it
+static bool is_true(const MemObject* obj) {
+  if (!obj || obj->get_type() == OBJECT_NULL) return false;
+  if (obj->get_type() == OBJECT_BOOL) return obj->get_value() != "false";
+  if (obj->get_type() == OBJECT_NUMBER) return obj->get_number() != 0;
+  return true;
+}
 
-  vector<string> args = func->get_arg_names();
-  vector<MemObject*> arr = mem.extract_array("arr");
+static void invalid_arguments(const char* name) {
+  cout << name << ": Invalid arguments. Aborting.\n";
+  exit(1);
+}
 
-  for (int i = 0; i < arr.size(); ++i) {
-    MemObject* elem = arr[i];
-    MemObject* new_elem =
-        new MemObject(elem->get_type(), args[1], elem->get_value());
+/**
+ * Walks array (or dictionary) storage and calls `callee` for each
+ * element in one reused frame. Callback takes (value) or (key, value),
+ * `step` receives position, element and result of call (owned) and
+ * returns false to stop iteration
+ */
+template <typename Step>
+static void iterate(MemoryKernel& mem, const char* name, MemObject* array,
+                    MemObject* callee, Step step) {
+  MemArray* arr = dynamic_cast<MemArray*>(array);
+  MemDict* dict = dynamic_cast<MemDict*>(array);
+  MemFunction* func = dynamic_cast<MemFunction*>(callee);
+  if ((!arr && !dict) || !func) invalid_arguments(name);
 
-    mem.enter_scope();
-    mem.mark_inside_func();
+  size_t argc = func->get_arg_names().size();
+  if (argc != 1 && argc != 2) invalid_arguments(name);
+
+  // callback may reassign variables holding array and function,
+  // so both are held here: storage is shared (writes to array
+  // detach from elements being iterated), function is copied
+  unique_ptr<MemObject> func_copy(func->copy_as(0));
+  CallFrame frame(mem, *static_cast<MemFunction*>(func_copy.get()));
+
+  if (dict) {
+    // entries in insertion order, keys are strings
+    shared_ptr<DictData> entries = dict->share();
+    for (size_t i = 0; i < entries->span(); ++i) {
+      MemObject* value = entries->at(i);
+      if (!value) continue;
+
+      if (argc == 2) {
+        frame.set_arg(0, OBJECT_STRING, entries->key_at(i));
+        frame.set_arg(1, *value);
+      } else {
+        frame.set_arg(0, *value);
+      }
+
+      if (!step(i, value, frame.call())) break;
+    }
+    return;
+  }
+
+  shared_ptr<ArrayData> elements = arr->share();
+  for (size_t i = 0; i < elements->size(); ++i) {
+    MemObject* elem = elements->at(i);
+
+    if (argc == 2) {
+      frame.set_arg(0, OBJECT_NUMBER, symbol_name(elements->key_at(i)));
+      frame.set_arg(1, *elem);
+    } else {
+      frame.set_arg(0, *elem);
+    }
+
+    if (!step(i, elem, frame.call())) break;
+  }
+}
+
+// result of callback (null if it returned nothing)
+static MemObject* take_result(MemObject* ret) {
+  return ret ? ret : new MemObject(OBJECT_NULL, 0, "null");
+}
+
+MemObject* builtin_for_each(MemoryKernel& mem, BuiltinArgs args) {
+  iterate(mem, "for_each", args[0], args[1],
+          [](size_t, MemObject*, MemObject* ret) {
+            delete ret;
+            return true;
+          });
+  return nullptr;
+}
+
+MemObject* builtin_map(MemoryKernel& mem, BuiltinArgs args) {
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  if (!arr) invalid_arguments("map");
+
+  // result has the same keys, so it shares shape of source
+  shared_ptr<ArrayData> source = arr->share();
+  vector<MemObject*> values;
+  values.reserve(source->size());
+
+  iterate(mem, "map", args[0], args[1],
+          [&](size_t i, MemObject*, MemObject* ret) {
+            MemObject* value = take_result(ret);
+            values.push_back(value->copy_as(source->key_at(i)));
+            delete value;
+            return true;
+          });
+
+  return new MemArray(0, make_shared<ArrayData>(source->share_shape(), values));
+}
+
+MemObject* builtin_filter(MemoryKernel& mem, BuiltinArgs args) {
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  if (!arr) invalid_arguments("filter");
+
+  // kept elements keep their keys
+  shared_ptr<ArrayData> source = arr->share();
+  shared_ptr<ArrayData> result = make_shared<ArrayData>();
+
+  iterate(mem, "filter", args[0], args[1],
+          [&](size_t i, MemObject* elem, MemObject* ret) {
+            if (is_true(ret))
+              result->set(source->key_at(i), elem->copy_as(source->key_at(i)));
+            delete ret;
+            return true;
+          });
+
+  return new MemArray(0, result);
+}
+
+MemObject* builtin_reduce(MemoryKernel& mem, BuiltinArgs args) {
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  MemFunction* func = dynamic_cast<MemFunction*>(args[1]);
+  if (!arr || !func || func->get_arg_names().size() != 2 || !args[2])
+    invalid_arguments("reduce");
+
+  // callback takes (accumulator, value)
+  shared_ptr<ArrayData> elements = arr->share();
+  unique_ptr<MemObject> func_copy(func->copy_as(0));
+  MemObject* acc = args[2]->copy_as(0);
+
+  CallFrame frame(mem, *static_cast<MemFunction*>(func_copy.get()));
+  for (size_t i = 0; i < elements->size(); ++i) {
+    frame.set_arg(0, *acc);
+    frame.set_arg(1, *elements->at(i));
+
+    delete acc;
+    acc = take_result(frame.call());
+  }
+
+  return acc;
+}
+
+MemObject* builtin_any(MemoryKernel& mem, BuiltinArgs args) {
+  bool found = false;
+  iterate(mem, "any", args[0], args[1],
+          [&](size_t, MemObject*, MemObject* ret) {
+            found = is_true(ret);
+            delete ret;
+            return !found;
+          });
+  return new MemObject(OBJECT_BOOL, 0, found ? "true" : "false");
+}
 
-    string elem_full_name = arr[i]->get_name();
-    string elem_name = elem_full_name.substr(elem_full_name.find("@") + 1);
+MemObject* builtin_all(MemoryKernel& mem, BuiltinArgs args) {
+  bool holds = true;
+  iterate(mem, "all", args[0], args[1],
+          [&](size_t, MemObject*, MemObject* ret) {
+            holds = is_true(ret);
+            delete ret;
+            return holds;
+          });
+  return new MemObject(OBJECT_BOOL, 0, holds ? "true" : "false");
+}
 
-    func->prep_mem(mem, {
-                            new MemObject(OBJECT_NUMBER, args[0], elem_name),
-                            new_elem,
-                        });
+/**********************************************************************
+ * Parallel higher-order builtins
+ *********************************************************************/
 
-    static_cast<AST::Block*>(func->get_entry_point())->eval(mem);
+/**
+ * Memory of pool worker: callback frame in own scopes,
+ * memory of caller is visible read-only
+ */
+struct ParallelWorker {
+  MemoryKernel mem;
+  unique_ptr<CallFrame> frame;
 
-    mem.unmark_inside_func();
+  ParallelWorker(const MemoryKernel& caller, const MemFunction& func)
+      : mem(&caller) {
+    mem.enter_scope();
+    frame.reset(new CallFrame(mem, func));
+  }
+
+  ~ParallelWorker() {
+    frame.reset();
     mem.exit_scope();
   }
+};
+
+/**
+ * Calls `callee` for each element of array on thread pool. Result of
+ * call for element `i` (owned) is passed to `store(i, ret)`, which
+ * is called by workers, once for each element. Callback takes
+ * (value) or (key, value) and must not write outer variables
+ */
+template <typename Store>
+static void par_iterate(MemoryKernel& mem, const char* name, MemObject* array,
+                        MemObject* callee, Store store) {
+  MemArray* arr = dynamic_cast<MemArray*>(array);
+  MemFunction* func = dynamic_cast<MemFunction*>(callee);
+  if (!arr || !func) invalid_arguments(name);
+
+  size_t argc = func->get_arg_names().size();
+  if (argc != 1 && argc != 2) invalid_arguments(name);
+
+  AST::prepare_parallel(mem, *func, name);
 
+  shared_ptr<ArrayData> elements = arr->share();
+  unique_ptr<MemObject> func_copy(func->copy_as(0));
+  const MemFunction& callback = *static_cast<MemFunction*>(func_copy.get());
+
+  // a few chunks per worker, so stealing can even out the load
+  ThreadPool& pool = ThreadPool::global();
+  size_t size = elements->size();
+  size_t parts = pool.size() * 4;
+  size_t step = max<size_t>(1, (size + parts - 1) / parts);
+  size_t chunks = (size + step - 1) / step;
+
+  // worker memory is created by worker on its first chunk
+  vector<unique_ptr<ParallelWorker>> workers(pool.size());
+
+  SymbolTable::global().set_concurrent(true);
+  pool.run(chunks, [&](size_t w, size_t chunk) {
+    MemoryKernel::set_worker(true);
+    if (!workers[w]) workers[w].reset(new ParallelWorker(mem, callback));
+    CallFrame& frame = *workers[w]->frame;
+
+    for (size_t i = chunk * step; i < min(size, (chunk + 1) * step); ++i) {
+      MemObject* elem = elements->at(i);
+      if (argc == 2) {
+        frame.set_arg(0, OBJECT_NUMBER, symbol_name(elements->key_at(i)));
+        frame.set_arg(1, *elem);
+      } else {
+        frame.set_arg(0, *elem);
+      }
+      store(i, frame.call());
+    }
+    MemoryKernel::set_worker(false);
+  });
+  SymbolTable::global().set_concurrent(false);
+
+  // bindings of worker memory were never tracked
+  MemoryKernel::set_worker(true);
+  workers.clear();
+  MemoryKernel::set_worker(false);
+}
+
+MemObject* builtin_par_for_each(MemoryKernel& mem, BuiltinArgs args) {
+  // nested parallel call runs in its worker sequentially
+  if (MemoryKernel::in_worker()) return builtin_for_each(mem, args);
+
+  par_iterate(mem, "par_for_each", args[0], args[1],
+              [](size_t, MemObject* ret) { delete ret; });
   return nullptr;
 }
 
+MemObject* builtin_par_map(MemoryKernel& mem, BuiltinArgs args) {
+  if (MemoryKernel::in_worker()) return builtin_map(mem, args);
+
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  if (!arr) invalid_arguments("par_map");
+
+  // each result has its slot, so order does not depend on scheduling
+  shared_ptr<ArrayData> source = arr->share();
+  vector<MemObject*> values(source->size(), nullptr);
+
+  par_iterate(mem, "par_map", args[0], args[1],
+              [&](size_t i, MemObject* ret) {
+                MemObject* value = take_result(ret);
+                values[i] = value->copy_as(source->key_at(i));
+                delete value;
+              });
+
+  return new MemArray(0, make_shared<ArrayData>(source->share_shape(), values));
+}
+
+/**********************************************************************
+ * Typed numeric arrays and their kernels
+ *********************************************************************/
+
+/**
+ * Numbers of array for kernels: buffer of typed array or numbers of
+ * generic array copied to `scratch`. Returns nullptr if `obj` is not
+ * an array or some element is not a number (empty array gives
+ * non-null pointer to no numbers)
+ */
+static const double* numbers_of(MemObject* obj, vector<double>& scratch,
+                                size_t& count) {
+  static const double none[1] = {0};
+
+  MemArray* arr = dynamic_cast<MemArray*>(obj);
+  if (!arr) return nullptr;
+
+  const ArrayData& elements = arr->elements();
+  count = elements.size();
+  if (!count) return none;
+  if (elements.is_typed()) return elements.number_data();
+
+  scratch.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    MemObject* elem = elements.at(i);
+    if (elem->get_type() != OBJECT_NUMBER) return nullptr;
+    scratch[i] = elem->get_number();
+  }
+  return scratch.data();
+}
+
+// shape with keys 0..n-1, as in array literal (keys are implicit)
+static shared_ptr<Shape> index_shape(size_t count) {
+  return Shape::indices(count);
+}
+
+static MemObject* number_result(double value) {
+  return new MemObject(0, value);
+}
+
+// typed array with keys of `shape_of` array
+static MemObject* typed_result(MemObject* shape_of, vector<double> numbers) {
+  shared_ptr<Shape> shape =
+      static_cast<MemArray*>(shape_of)->elements().share_shape();
+  return new MemArray(0, make_shared<ArrayData>(shape, std::move(numbers)));
+}
+
+MemObject* builtin_typed(MemoryKernel& mem, BuiltinArgs args) {
+  vector<double> scratch;
+  size_t count;
+  const double* x = numbers_of(args[0], scratch, count);
+  if (!x) invalid_arguments("typed");
+  return typed_result(args[0], vector<double>(x, x + count));
+}
+
+MemObject* builtin_fill(MemoryKernel& mem, BuiltinArgs args) {
+  if (args[0]->get_type() != OBJECT_NUMBER || args[0]->get_number() < 0 ||
+      args[1]->get_type() != OBJECT_NUMBER)
+    invalid_arguments("fill");
+
+  size_t count = args[0]->get_number();
+  vector<double> numbers(count, args[1]->get_number());
+  return new MemArray(0, make_shared<ArrayData>(index_shape(count),
+                                                std::move(numbers)));
+}
+
+MemObject* builtin_sum(MemoryKernel& mem, BuiltinArgs args) {
+  vector<double> scratch;
+  size_t count;
+  const double* x = numbers_of(args[0], scratch, count);
+  if (!x) invalid_arguments("sum");
+  return number_result(VecMath::sum(x, count));
+}
+
+MemObject* builtin_min(MemoryKernel& mem, BuiltinArgs args) {
+  vector<double> scratch;
+  size_t count;
+  const double* x = numbers_of(args[0], scratch, count);
+  if (!x) invalid_arguments("min");
+  if (!count) return new MemObject(OBJECT_NULL, 0, "null");
+  return number_result(VecMath::min(x, count));
+}
+
+MemObject* builtin_max(MemoryKernel& mem, BuiltinArgs args) {
+  vector<double> scratch;
+  size_t count;
+  const double* x = numbers_of(args[0], scratch, count);
+  if (!x) invalid_arguments("max");
+  if (!count) return new MemObject(OBJECT_NULL, 0, "null");
+  return number_result(VecMath::max(x, count));
+}
+
+MemObject* builtin_dot(MemoryKernel& mem, BuiltinArgs args) {
+  vector<double> scratch_x, scratch_y;
+  size_t count_x, count_y;
+  const double* x = numbers_of(args[0], scratch_x, count_x);
+  const double* y = numbers_of(args[1], scratch_y, count_y);
+  if (!x || !y || count_x != count_y) invalid_arguments("dot");
+  return number_result(VecMath::dot(x, y, count_x));
+}
+
+MemObject* builtin_scale(MemoryKernel& mem, BuiltinArgs args) {
+  vector<double> scratch;
+  size_t count;
+  const double* x = numbers_of(args[0], scratch, count);
+  if (!x || args[1]->get_type() != OBJECT_NUMBER) invalid_arguments("scale");
+
+  vector<double> out(count);
+  VecMath::scale(x, args[1]->get_number(), out.data(), count);
+  return typed_result(args[0], std::move(out));
+}
+
+// elementwise kernel over two arrays of the same length
+template <typename Kernel>
+static MemObject* elementwise(const char* name, BuiltinArgs args,
+                              Kernel kernel) {
+  vector<double> scratch_x, scratch_y;
+  size_t count_x, count_y;
+  const double* x = numbers_of(args[0], scratch_x, count_x);
+  const double* y = numbers_of(args[1], scratch_y, count_y);
+  if (!x || !y || count_x != count_y) invalid_arguments(name);
+
+  vector<double> out(count_x);
+  kernel(x, y, out.data(), count_x);
+  return typed_result(args[0], std::move(out));
+}
+
+MemObject* builtin_vec_add(MemoryKernel& mem, BuiltinArgs args) {
+  return elementwise("vec_add", args, VecMath::add);
+}
+
+MemObject* builtin_vec_mul(MemoryKernel& mem, BuiltinArgs args) {
+  return elementwise("vec_mul", args, VecMath::mul);
+}
+
+/**********************************************************************
+ * Sorting and binary search
+ *********************************************************************/
+
+// all elements of array have type `type`
+static bool all_of_type(const ArrayData& elements, ObjectType type) {
+  for (size_t i = 0; i < elements.size(); ++i)
+    if (elements.at(i)->get_type() != type) return false;
+  return true;
+}
+
+// NaN is not ordered, so it is moved to the end before sorting
+static bool not_nan(double value) { return value == value; }
+
+MemObject* builtin_sort(MemoryKernel& mem, BuiltinArgs args) {
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  if (!arr) invalid_arguments("sort");
+
+  // sorted array gets keys 0..n-1
+  shared_ptr<ArrayData> source = arr->share();
+  size_t count = source->size();
+  shared_ptr<Shape> shape = index_shape(count);
+  bool by_callback = args.size() > 1 && args[1];
+
+  // typed array: buffer is sorted as is
+  if (source->is_typed() && !by_callback) {
+    vector<double> numbers(source->number_data(),
+                           source->number_data() + count);
+    auto end = partition(numbers.begin(), numbers.end(), not_nan);
+    sort(numbers.begin(), end);
+    return new MemArray(0, make_shared<ArrayData>(shape, std::move(numbers)));
+  }
+
+  // positions of elements in sorted order
+  vector<size_t> order(count);
+  for (size_t i = 0; i < count; ++i) order[i] = i;
+
+  if (by_callback) {
+    // cmp(a, b) is true if a goes before b, stable sort keeps
+    // order of equal elements and tolerates inconsistent callback
+    MemFunction* func = dynamic_cast<MemFunction*>(args[1]);
+    if (!func || func->get_arg_names().size() != 2) invalid_arguments("sort");
+
+    unique_ptr<MemObject> func_copy(func->copy_as(0));
+    CallFrame frame(mem, *static_cast<MemFunction*>(func_copy.get()));
+    stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      frame.set_arg(0, *source->at(a));
+      frame.set_arg(1, *source->at(b));
+      MemObject* ret = frame.call();
+      bool before = is_true(ret);
+      delete ret;
+      return before;
+    });
+  } else if (all_of_type(*source, OBJECT_NUMBER)) {
+    // numbers are compared without calls into interpreter,
+    // equal numbers keep their order
+    vector<pair<double, size_t>> keys(count);
+    for (size_t i = 0; i < count; ++i)
+      keys[i] = {source->at(i)->get_number(), i};
+    auto end = partition(keys.begin(), keys.end(),
+                         [](const pair<double, size_t>& key) {
+                           return not_nan(key.first);
+                         });
+    sort(keys.begin(), end);
+    for (size_t i = 0; i < count; ++i) order[i] = keys[i].second;
+  } else if (all_of_type(*source, OBJECT_STRING)) {
+    sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      int diff = source->at(a)->get_value().compare(source->at(b)->get_value());
+      return diff < 0 || (diff == 0 && a < b);
+    });
+  } else {
+    invalid_arguments("sort");
+  }
+
+  vector<MemObject*> values;
+  values.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+    values.push_back(source->at(order[i])->copy_as(shape->key_at(i)));
+  return new MemArray(0, make_shared<ArrayData>(shape, values));
+}
+
+MemObject* builtin_bsearch(MemoryKernel& mem, BuiltinArgs args) {
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  ObjectType type = args[1]->get_type();
+  if (!arr || (type != OBJECT_NUMBER && type != OBJECT_STRING))
+    invalid_arguments("bsearch");
+
+  // array is sorted ascending, elements have the type of `x`
+  const ArrayData& elements = arr->elements();
+  const double* numbers = elements.number_data();
+  if (numbers && type != OBJECT_NUMBER) invalid_arguments("bsearch");
+  double number = type == OBJECT_NUMBER ? args[1]->get_number() : 0;
+
+  // NaN equals nothing, so it is never found
+  if (!not_nan(number)) return number_result(-1);
+
+  // sign of `value` - x, NaN goes after every number as in sort
+  auto compare_number = [&](double value) -> int {
+    if (!not_nan(value)) return 1;
+    return value < number ? -1 : value > number;
+  };
+
+  // sign of (element at `pos`) - x
+  auto compare = [&](size_t pos) -> int {
+    if (numbers) return compare_number(numbers[pos]);
+
+    MemObject* elem = elements.at(pos);
+    if (elem->get_type() != type) invalid_arguments("bsearch");
+    if (type == OBJECT_STRING)
+      return elem->get_value().compare(args[1]->get_value());
+    return compare_number(elem->get_number());
+  };
+
+  // first position which is not less than x
+  size_t low = 0, high = elements.size();
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (compare(mid) < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  bool found = low < elements.size() && compare(low) == 0;
+  return number_result(found ? (double)low : -1);
+}
+
+/**********************************************************************
+ * Dictionaries
+ *********************************************************************/
+
+static MemDict* dict_of(const char* name, MemObject* obj) {
+  MemDict* dict = dynamic_cast<MemDict*>(obj);
+  if (!dict) invalid_arguments(name);
+  return dict;
+}
+
+MemObject* builtin_has(MemoryKernel& mem, BuiltinArgs args) {
+  MemDict* dict = dict_of("has", args[0]);
+  bool found = dict->entries().get(AST::ArrayEl::index_text(args[1]));
+  return new MemObject(OBJECT_BOOL, 0, found ? "true" : "false");
+}
+
+MemObject* builtin_get(MemoryKernel& mem, BuiltinArgs args) {
+  MemDict* dict = dict_of("get", args[0]);
+  MemObject* value = dict->entries().get(AST::ArrayEl::index_text(args[1]));
+  if (value) return value->copy_as(0);
+
+  // default value (null if it is omitted)
+  if (args.size() > 2 && args[2]) return args[2]->copy_as(0);
+  return new MemObject(OBJECT_NULL, 0, "null");
+}
+
+// `set` and `remove` change dictionary in place
+MemObject* builtin_set(MemoryKernel& mem, BuiltinArgs args) {
+  MemDict* dict = dict_of("set", args[0]);
+  mem.check_modify(dict);
+  dict->mutable_entries().set(AST::ArrayEl::index_text(args[1]),
+                              args[2]->copy_as(0));
+  return nullptr;
+}
+
+MemObject* builtin_remove(MemoryKernel& mem, BuiltinArgs args) {
+  MemDict* dict = dict_of("remove", args[0]);
+  mem.check_modify(dict);
+  bool removed =
+      dict->mutable_entries().remove(AST::ArrayEl::index_text(args[1]));
+  return new MemObject(OBJECT_BOOL, 0, removed ? "true" : "false");
+}
+
+MemObject* builtin_keys(MemoryKernel& mem, BuiltinArgs args) {
+  const DictData& entries = dict_of("keys", args[0])->entries();
+
+  vector<MemObject*> values;
+  values.reserve(entries.size());
+  for (size_t i = 0; i < entries.span(); ++i) {
+    if (!entries.at(i)) continue;
+    values.push_back(new MemObject(OBJECT_STRING, intern(to_string(values.size())),
+                                   entries.key_at(i)));
+  }
+  return new MemArray(0, make_shared<ArrayData>(index_shape(values.size()), values));
+}
+
+/**********************************************************************
+ * Strings
+ *********************************************************************/
+
+static const string& string_of(const char* name, MemObject* obj) {
+  if (!obj || obj->get_type() != OBJECT_STRING) invalid_arguments(name);
+  return obj->get_value();
+}
+
+// optional number argument (`fallback` if it is omitted)
+static double number_of(const char* name, BuiltinArgs args, size_t pos,
+                        double fallback) {
+  if (pos >= args.size() || !args[pos]) return fallback;
+  if (args[pos]->get_type() != OBJECT_NUMBER) invalid_arguments(name);
+  return args[pos]->get_number();
+}
+
+// position in [0, size] nearest to `pos`
+static size_t clamp_position(double pos, size_t size) {
+  if (!(pos > 0)) return 0;
+  return pos < (double)size ? (size_t)pos : size;
+}
+
+/**
+ * First occurrence of `needle` in `text` starting at `from` (or npos).
+ * Candidates are found by memchr (vectorized by libc) on the first
+ * byte of needle, only they are compared completely
+ */
+static size_t find_text(string_view text, string_view needle, size_t from) {
+  if (needle.empty()) return from <= text.size() ? from : string_view::npos;
+  if (needle.size() > text.size()) return string_view::npos;
+
+  const char* begin = text.data();
+  const char* last = begin + text.size() - needle.size();
+  for (const char* p = begin + from; p <= last; ++p) {
+    p = static_cast<const char*>(memchr(p, needle[0], last - p + 1));
+    if (!p) break;
+    if (memcmp(p + 1, needle.data() + 1, needle.size() - 1) == 0)
+      return p - begin;
+  }
+  return string_view::npos;
+}
+
+static MemObject* string_result(string value) {
+  return new MemObject(OBJECT_STRING, 0, std::move(value));
+}
+
+MemObject* builtin_len(MemoryKernel& mem, BuiltinArgs args) {
+  if (MemArray* arr = dynamic_cast<MemArray*>(args[0]))
+    return number_result(arr->elements().size());
+  if (MemDict* dict = dynamic_cast<MemDict*>(args[0]))
+    return number_result(dict->entries().size());
+  return number_result(string_of("len", args[0]).size());
+}
+
+MemObject* builtin_substr(MemoryKernel& mem, BuiltinArgs args) {
+  const string& text = string_of("substr", args[0]);
+  size_t start = clamp_position(number_of("substr", args, 1, 0), text.size());
+  size_t count = clamp_position(number_of("substr", args, 2, text.size()),
+                                text.size() - start);
+  return string_result(text.substr(start, count));
+}
+
+MemObject* builtin_find(MemoryKernel& mem, BuiltinArgs args) {
+  const string& text = string_of("find", args[0]);
+  const string& needle = string_of("find", args[1]);
+  size_t from = clamp_position(number_of("find", args, 2, 0), text.size());
+
+  size_t pos = find_text(text, needle, from);
+  return number_result(pos == string_view::npos ? -1 : (double)pos);
+}
+
+MemObject* builtin_split(MemoryKernel& mem, BuiltinArgs args) {
+  string_view text = string_of("split", args[0]);
+  string_view sep = string_of("split", args[1]);
+
+  // empty separator splits string into characters
+  vector<string_view> parts;
+  if (sep.empty()) {
+    for (size_t i = 0; i < text.size(); ++i) parts.push_back(text.substr(i, 1));
+  } else {
+    size_t start = 0, pos;
+    while ((pos = find_text(text, sep, start)) != string_view::npos) {
+      parts.push_back(text.substr(start, pos - start));
+      start = pos + sep.size();
+    }
+    parts.push_back(text.substr(start));
+  }
+
+  shared_ptr<Shape> shape = index_shape(parts.size());
+  vector<MemObject*> values;
+  values.reserve(parts.size());
+  for (size_t i = 0; i < parts.size(); ++i)
+    values.push_back(
+        new MemObject(OBJECT_STRING, shape->key_at(i), string(parts[i])));
+  return new MemArray(0, make_shared<ArrayData>(shape, values));
+}
+
+MemObject* builtin_join(MemoryKernel& mem, BuiltinArgs args) {
+  MemArray* arr = dynamic_cast<MemArray*>(args[0]);
+  if (!arr) invalid_arguments("join");
+  const string& sep = string_of("join", args[1]);
+  const ArrayData& elements = arr->elements();
+
+  // output is sized once
+  size_t length = elements.size() ? sep.size() * (elements.size() - 1) : 0;
+  for (size_t i = 0; i < elements.size(); ++i)
+    length += elements.at(i)->get_value().size();
+
+  string result;
+  result.reserve(length);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    if (i) result += sep;
+    result += elements.at(i)->get_value();
+  }
+  return string_result(std::move(result));
+}
+
+MemObject* builtin_replace(MemoryKernel& mem, BuiltinArgs args) {
+  const string& text = string_of("replace", args[0]);
+  const string& from = string_of("replace", args[1]);
+  const string& to = string_of("replace", args[2]);
+  if (from.empty()) return string_result(text);
+
+  // every occurrence is replaced in one pass
+  string result;
+  result.reserve(text.size());
+  size_t start = 0, pos;
+  while ((pos = find_text(text, from, start)) != string_view::npos) {
+    result.append(text, start, pos - start);
+    result += to;
+    start = pos + from.size();
+  }
+  result.append(text, start, string::npos);
+  return string_result(std::move(result));
+}
+
+MemObject* builtin_upper(MemoryKernel& mem, BuiltinArgs args) {
+  string result = string_of("upper", args[0]);
+  for (char& c : result) c = toupper((unsigned char)c);
+  return string_result(std::move(result));
+}
+
+MemObject* builtin_lower(MemoryKernel& mem, BuiltinArgs args) {
+  string result = string_of("lower", args[0]);
+  for (char& c : result) c = tolower((unsigned char)c);
+  return string_result(std::move(result));
+}
+
+/**********************************************************************
+ * Raw binary files
+ *********************************************************************/
+
+static void file_error(const char* name, const string& path) {
+  cout << name << ": Can not access file '" << path << "'. Aborting.\n";
+  exit(1);
+}
+
+/**
+ * Maps whole file read-only, pages are read by the kernel on first
+ * access. Mapping is released when the last array using it is gone.
+ * Returns nullptr for empty file
+ */
+static shared_ptr<const void> map_file(const char* name, const string& path,
+                                       size_t& size) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) file_error(name, path);
+
+  struct stat info;
+  if (fstat(fd, &info) < 0) {
+    close(fd);
+    file_error(name, path);
+  }
+
+  size = info.st_size;
+  if (!size) {
+    close(fd);
+    return nullptr;
+  }
+
+  // mapping stays valid after descriptor is closed
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) file_error(name, path);
+
+  return shared_ptr<const void>(
+      data, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+}
+
+MemObject* builtin_load_f64(MemoryKernel& mem, BuiltinArgs args) {
+  const string& path = string_of("load_f64", args[0]);
+  size_t size;
+  shared_ptr<const void> file = map_file("load_f64", path, size);
+  size_t count = file ? size / sizeof(double) : 0;
+
+  // typed array reads mapped pages directly (no copy)
+  const double* numbers = static_cast<const double*>(file.get());
+  return new MemArray(0, make_shared<ArrayData>(index_shape(count), file,
+                                                numbers, count));
+}
+
+MemObject* builtin_load_i32(MemoryKernel& mem, BuiltinArgs args) {
+  const string& path = string_of("load_i32", args[0]);
+  size_t size;
+  shared_ptr<const void> file = map_file("load_i32", path, size);
+  size_t count = file ? size / sizeof(int32_t) : 0;
+
+  // typed arrays hold doubles, so integers are converted once
+  const int32_t* integers = static_cast<const int32_t*>(file.get());
+  vector<double> numbers(integers, integers + count);
+  return new MemArray(0, make_shared<ArrayData>(index_shape(count),
+                                                std::move(numbers)));
+}
+
+MemObject* builtin_store_f64(MemoryKernel& mem, BuiltinArgs args) {
+  const string& path = string_of("store_f64", args[0]);
+  vector<double> scratch;
+  size_t count = 0;
+  const double* x = numbers_of(args[1], scratch, count);
+  if (!x) invalid_arguments("store_f64");
+
+  // file is replaced by rename, so arrays still mapping the old
+  // file (e.g. the one being stored) keep their pages
+  string temp = path + ".tmp";
+  int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) file_error("store_f64", path);
+
+  // buffer goes out in one write (loop only resumes partial writes)
+  const char* data = reinterpret_cast<const char*>(x);
+  size_t left = count * sizeof(double);
+  while (left) {
+    ssize_t written = write(fd, data, left);
+    if (written < 0) {
+      close(fd);
+      file_error("store_f64", path);
+    }
+    data += written;
+    left -= written;
+  }
+  close(fd);
+  if (rename(temp.c_str(), path.c_str()) < 0) file_error("store_f64", path);
+
+  return number_result(count);
+}
+
+/**********************************************************************
+ * CSV files
+ *********************************************************************/
+
+// keys of columns are names from header, empty or repeated
+// name is replaced by position of column
+static shared_ptr<Shape> header_shape(const vector<string_view>& header) {
+  shared_ptr<Shape> shape = make_shared<Shape>(false);
+  for (size_t i = 0; i < header.size(); ++i) {
+    Symbol key = intern(header[i]);
+    if (!key || shape->offset(key) >= 0) key = index_symbol(i);
+    while (shape->offset(key) >= 0) key = intern(symbol_name(key) + "_");
+    shape->append(key);
+  }
+  return shape;
+}
+
+/**
+ * Next record of file, records with more than `columns` fields or
+ * with quote left open are rejected. `record` counts records read
+ */
+static bool next_record(CsvReader& reader, vector<string_view>& fields,
+                        size_t columns, const string& path, size_t& record) {
+  if (!reader.next(fields)) return false;
+  ++record;
+  if (fields.size() > columns || !reader.closed()) {
+    cout << "read_csv: Malformed record " << record << " in file '" << path
+         << "'. Aborting.\n";
+    exit(1);
+  }
+  return true;
+}
+
+// field of record, missing fields are empty
+static string_view field_at(const vector<string_view>& fields, size_t pos) {
+  return pos < fields.size() ? fields[pos] : string_view();
+}
+
+/**
+ * Column of CSV file: numbers while every field is a number (empty
+ * field is nan), strings after the first other field (numbers read
+ * before it are formatted back, nan becomes empty string)
+ */
+class CsvColumn {
+ private:
+  vector<double> numbers;
+  vector<string> texts;
+  bool numeric = true;
+
+ public:
+  void add(string_view field) {
+    if (numeric) {
+      double value;
+      if (field.empty()) {
+        numbers.push_back(NAN);
+        return;
+      }
+      if (NumberFormat::parse_exact(field, value)) {
+        numbers.push_back(value);
+        return;
+      }
+
+      numeric = false;
+      texts.reserve(numbers.size() + 1);
+      for (double number : numbers)
+        texts.push_back(number == number ? NumberFormat::format(number) : "");
+      vector<double>().swap(numbers);
+    }
+    texts.emplace_back(field);
+  }
+
+  // typed array of numbers or array of strings
+  MemObject* result(Symbol name) {
+    if (numeric) {
+      size_t count = numbers.size();
+      return new MemArray(name, make_shared<ArrayData>(index_shape(count),
+                                                       std::move(numbers)));
+    }
+
+    vector<MemObject*> values;
+    values.reserve(texts.size());
+    for (size_t i = 0; i < texts.size(); ++i)
+      values.push_back(
+          new MemObject(OBJECT_STRING, index_symbol(i), std::move(texts[i])));
+    return new MemArray(name, make_shared<ArrayData>(
+                                  index_shape(values.size()), values));
+  }
+};
+
+/**
+ * Calls `callee` for each record in one reused frame, only one record
+ * is kept in memory. Callback takes (row) or (position, row), row is
+ * a tuple keyed by header with numbers and strings
+ */
+static MemObject* csv_rows(MemoryKernel& mem, CsvReader& reader,
+                           const string& path, shared_ptr<Shape> shape,
+                           MemObject* callee) {
+  MemFunction* func = dynamic_cast<MemFunction*>(callee);
+  if (!func) invalid_arguments("read_csv");
+  size_t argc = func->get_arg_names().size();
+  if (argc != 1 && argc != 2) invalid_arguments("read_csv");
+
+  unique_ptr<MemObject> func_copy(func->copy_as(0));
+  CallFrame frame(mem, *static_cast<MemFunction*>(func_copy.get()));
+
+  vector<string_view> fields;
+  size_t count = 0, record = 1;
+  while (next_record(reader, fields, shape->size(), path, record)) {
+    vector<MemObject*> values;
+    values.reserve(shape->size());
+    for (size_t i = 0; i < shape->size(); ++i) {
+      // numbers keep their text, as number literals do
+      string_view field = field_at(fields, i);
+      double value;
+      ObjectType type =
+          NumberFormat::parse_exact(field, value) ? OBJECT_NUMBER : OBJECT_STRING;
+      values.push_back(new MemObject(type, shape->key_at(i), string(field)));
+    }
+    MemArray row(0, make_shared<ArrayData>(shape, values));
+
+    if (argc == 2) {
+      frame.set_arg(0, OBJECT_NUMBER, to_string(count));
+      frame.set_arg(1, row);
+    } else {
+      frame.set_arg(0, row);
+    }
+    delete frame.call();
+    ++count;
+  }
+  return number_result(count);
+}
+
+MemObject* builtin_read_csv(MemoryKernel& mem, BuiltinArgs args) {
+  const string& path = string_of("read_csv", args[0]);
+  CsvReader reader;
+  if (!reader.open(path)) file_error("read_csv", path);
+
+  // first record names columns
+  vector<string_view> fields;
+  size_t record = 0;
+  next_record(reader, fields, SIZE_MAX, path, record);
+  shared_ptr<Shape> shape = header_shape(fields);
+
+  if (args.size() > 1 && args[1])
+    return csv_rows(mem, reader, path, shape, args[1]);
+
+  vector<CsvColumn> columns(shape->size());
+  while (next_record(reader, fields, columns.size(), path, record))
+    for (size_t i = 0; i < columns.size(); ++i)
+      columns[i].add(field_at(fields, i));
+
+  vector<MemObject*> values;
+  values.reserve(columns.size());
+  for (size_t i = 0; i < columns.size(); ++i)
+    values.push_back(columns[i].result(shape->key_at(i)));
+  return new MemArray(0, make_shared<ArrayData>(shape, values));
+}
+
+/**********************************************************************
+ * JSON
+ *********************************************************************/
+
+/**
+ * Single pass parser of JSON text into memory objects: objects become
+ * tuples, arrays become arrays (typed arrays when all elements are
+ * numbers). Every value is created once, with its final key
+ */
+class JsonParser {
+ private:
+  string_view text;
+  size_t pos = 0;
+  size_t depth = 0;
+
+  // nesting deeper than this is rejected (parser is recursive)
+  static const size_t MAX_DEPTH = 512;
+
+  [[noreturn]] void fail() {
+    cout << "json_parse: Invalid JSON at position " << pos << ". Aborting.\n";
+    exit(1);
+  }
+
+  void skip_space() {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' ||
+                                 text[pos] == '\r' || text[pos] == '\t'))
+      ++pos;
+  }
+
+  bool consume(char c) {
+    skip_space();
+    if (pos == text.size() || text[pos] != c) return false;
+    ++pos;
+    return true;
+  }
+
+  void expect(char c) {
+    if (!consume(c)) fail();
+  }
+
+  void literal(string_view word) {
+    if (text.substr(pos, word.size()) != word) fail();
+    pos += word.size();
+  }
+
+  bool digit() const { return pos < text.size() && isdigit(text[pos]); }
+
+  void digits() {
+    if (!digit()) fail();
+    while (digit()) ++pos;
+  }
+
+  // text of number at `pos` (as JSON grammar defines it)
+  string_view number_text() {
+    size_t start = pos;
+    if (pos < text.size() && text[pos] == '-') ++pos;
+    if (pos < text.size() && text[pos] == '0')
+      ++pos;
+    else
+      digits();
+    if (pos < text.size() && text[pos] == '.') {
+      ++pos;
+      digits();
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+      ++pos;
+      if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) ++pos;
+      digits();
+    }
+    return text.substr(start, pos - start);
+  }
+
+  unsigned hex4() {
+    if (pos + 4 > text.size()) fail();
+    unsigned code = 0;
+    for (size_t end = pos + 4; pos < end; ++pos) {
+      char c = text[pos];
+      int value = isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10);
+      if (!isxdigit(c)) fail();
+      code = code * 16 + value;
+    }
+    return code;
+  }
+
+  // \uXXXX escape (with surrogate pair) as UTF-8
+  void unicode(string& out) {
+    unsigned code = hex4();
+    if (code >= 0xD800 && code < 0xDC00) {
+      if (text.substr(pos, 2) != "\\u") fail();
+      pos += 2;
+      unsigned low = hex4();
+      if (low < 0xDC00 || low >= 0xE000) fail();
+      code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    if (code < 0x80) {
+      out += (char)code;
+    } else if (code < 0x800) {
+      out += (char)(0xC0 | code >> 6);
+      out += (char)(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+      out += (char)(0xE0 | code >> 12);
+      out += (char)(0x80 | (code >> 6 & 0x3F));
+      out += (char)(0x80 | (code & 0x3F));
+    } else {
+      out += (char)(0xF0 | code >> 18);
+      out += (char)(0x80 | (code >> 12 & 0x3F));
+      out += (char)(0x80 | (code >> 6 & 0x3F));
+      out += (char)(0x80 | (code & 0x3F));
+    }
+  }
+
+  // string at `pos` (opening quote), spans without escapes are copied
+  // at once
+  string string_text() {
+    string result;
+    size_t start = ++pos;
+    while (true) {
+      if (pos == text.size()) fail();
+      char c = text[pos];
+      if (c == '"') break;
+      if ((unsigned char)c < 0x20) fail();
+      if (c != '\\') {
+        ++pos;
+        continue;
+      }
+
+      result.append(text.data() + start, pos - start);
+      if (++pos == text.size()) fail();
+      switch (text[pos++]) {
+        case '"': result += '"'; break;
+        case '\\': result += '\\'; break;
+        case '/': result += '/'; break;
+        case 'b': result += '\b'; break;
+        case 'f': result += '\f'; break;
+        case 'n': result += '\n'; break;
+        case 'r': result += '\r'; break;
+        case 't': result += '\t'; break;
+        case 'u': unicode(result); break;
+        default: --pos; fail();
+      }
+      start = pos;
+    }
+    result.append(text.data() + start, pos - start);
+    ++pos;
+    return result;
+  }
+
+  bool number_ahead() const {
+    return pos < text.size() && (text[pos] == '-' || isdigit(text[pos]));
+  }
+
+  MemObject* array(Symbol key) {
+    ++pos;
+    // numbers are kept unboxed until the first other element
+    vector<double> numbers;
+    vector<MemObject*> values;
+    bool typed = true;
+
+    if (!consume(']')) {
+      do {
+        skip_space();
+        if (typed && number_ahead()) {
+          numbers.push_back(NumberFormat::parse(number_text()));
+          continue;
+        }
+        if (typed) {
+          typed = false;
+          values.reserve(numbers.size() + 1);
+          for (size_t i = 0; i < numbers.size(); ++i)
+            values.push_back(new MemObject(index_symbol(i), numbers[i]));
+        }
+        values.push_back(value(index_symbol(values.size())));
+      } while (consume(','));
+      expect(']');
+    }
+
+    if (typed) {
+      size_t count = numbers.size();
+      return new MemArray(key, make_shared<ArrayData>(index_shape(count),
+                                                      std::move(numbers)));
+    }
+    size_t count = values.size();
+    return new MemArray(key, make_shared<ArrayData>(index_shape(count), values));
+  }
+
+  MemObject* object(Symbol key) {
+    // objects with the same keys share shape (see `Shape::add`)
+    static const shared_ptr<Shape> root = make_shared<Shape>(true);
+
+    ++pos;
+    shared_ptr<ArrayData> fields =
+        make_shared<ArrayData>(root, vector<MemObject*>());
+    if (!consume('}')) {
+      do {
+        skip_space();
+        if (pos == text.size() || text[pos] != '"') fail();
+        Symbol field = intern(string_text());
+        expect(':');
+        fields->set(field, value(field));
+      } while (consume(','));
+      expect('}');
+    }
+    return new MemArray(key, fields);
+  }
+
+ public:
+  explicit JsonParser(string_view text) : text(text) {}
+
+  // value at `pos` named `key`
+  MemObject* value(Symbol key) {
+    skip_space();
+    if (pos == text.size() || depth == MAX_DEPTH) fail();
+
+    switch (text[pos]) {
+      case '{': {
+        ++depth;
+        MemObject* result = object(key);
+        --depth;
+        return result;
+      }
+      case '[': {
+        ++depth;
+        MemObject* result = array(key);
+        --depth;
+        return result;
+      }
+      case '"':
+        return new MemObject(OBJECT_STRING, key, string_text());
+      case 't':
+        literal("true");
+        return new MemObject(OBJECT_BOOL, key, "true");
+      case 'f':
+        literal("false");
+        return new MemObject(OBJECT_BOOL, key, "false");
+      case 'n':
+        literal("null");
+        return new MemObject(OBJECT_NULL, key, "null");
+      default:
+        // numbers keep their text, as number literals do
+        return new MemObject(OBJECT_NUMBER, key, string(number_text()));
+    }
+  }
+
+  // whole text is one value
+  MemObject* parse() {
+    MemObject* result = value(0);
+    skip_space();
+    if (pos != text.size()) fail();
+    return result;
+  }
+};
+
+// array with keys 0..n-1 is written as JSON array, other arrays
+// and tuples as objects
+static bool is_list(const ArrayData& elements) {
+  if (elements.shape()->implicit_keys()) return true;
+  for (size_t i = 0; i < elements.size(); ++i)
+    if (elements.key_at(i) != index_symbol(i)) return false;
+  return true;
+}
+
+static void write_json(JsonWriter& out, const MemObject* obj) {
+  switch (obj->get_type()) {
+    case OBJECT_STRING:
+      out.text(obj->get_value());
+      return;
+    case OBJECT_NUMBER: {
+      long long value;
+      if (obj->get_integer(value))
+        out.integer(value);
+      else
+        out.number(obj->get_number());
+      return;
+    }
+    case OBJECT_BOOL:
+      out.raw(obj->get_value() == "false" ? "false" : "true");
+      return;
+    case OBJECT_DICT: {
+      const DictData& entries = static_cast<const MemDict*>(obj)->entries();
+      bool first = true;
+      out.raw('{');
+      for (size_t i = 0; i < entries.span(); ++i) {
+        MemObject* value = entries.at(i);
+        if (!value) continue;
+        if (!first) out.raw(',');
+        first = false;
+        out.text(entries.key_at(i));
+        out.raw(':');
+        write_json(out, value);
+      }
+      out.raw('}');
+      return;
+    }
+    case OBJECT_ARRAY:
+      break;
+    default:
+      out.raw("null");
+      return;
+  }
+
+  const ArrayData& elements = static_cast<const MemArray*>(obj)->elements();
+  bool list = is_list(elements);
+  out.raw(list ? '[' : '{');
+
+  // typed buffer is written without element objects
+  if (list && elements.is_typed() && !elements.has_elements()) {
+    const double* numbers = elements.number_data();
+    for (size_t i = 0; i < elements.size(); ++i) {
+      if (i) out.raw(',');
+      out.number(numbers[i]);
+    }
+    out.raw(']');
+    return;
+  }
+
+  for (size_t i = 0; i < elements.size(); ++i) {
+    if (i) out.raw(',');
+    if (!list) {
+      out.text(symbol_name(elements.key_at(i)));
+      out.raw(':');
+    }
+    write_json(out, elements.at(i));
+  }
+  out.raw(list ? ']' : '}');
+}
+
+MemObject* builtin_json_parse(MemoryKernel& mem, BuiltinArgs args) {
+  return JsonParser(string_of("json_parse", args[0])).parse();
+}
+
+MemObject* builtin_json_stringify(MemoryKernel& mem, BuiltinArgs args) {
+  string result;
+  JsonWriter out(result);
+  write_json(out, args[0]);
+  return string_result(std::move(result));
+}
+
+/**********************************************************************
+ * Standard input
+ *********************************************************************/
+
+/**
+ * Calls `callee` for each line of standard input in one reused frame.
+ * Input is read in big chunks into one buffer, line is copied only
+ * into reused argument (no allocation per line), so memory does not
+ * depend on input size. Callback takes (line) or (position, line),
+ * line has no line end ("\n" or "\r\n")
+ */
+MemObject* builtin_lines(MemoryKernel& mem, BuiltinArgs args) {
+  static const size_t CHUNK_SIZE = 1 << 20;
+
+  MemFunction* func = dynamic_cast<MemFunction*>(args[0]);
+  if (!func) invalid_arguments("lines");
+  size_t argc = func->get_arg_names().size();
+  if (argc != 1 && argc != 2) invalid_arguments("lines");
+
+  unique_ptr<MemObject> func_copy(func->copy_as(0));
+  CallFrame frame(mem, *static_cast<MemFunction*>(func_copy.get()));
+
+  // bytes [begin, end) of buffer are not processed yet
+  // (read through cin, as other input builtins use it)
+  streambuf* input = cin.rdbuf();
+  vector<char> buffer(CHUNK_SIZE);
+  size_t begin = 0, end = 0, count = 0;
+  bool eof = false;
+
+  while (true) {
+    const char* data = buffer.data();
+    const char* line = (const char*)memchr(data + begin, '\n', end - begin);
+    if (!line && !eof) {
+      memmove(buffer.data(), data + begin, end - begin);
+      end -= begin;
+      begin = 0;
+      // line longer than buffer
+      if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+
+      streamsize read = input->sgetn(buffer.data() + end, buffer.size() - end);
+      if (read <= 0)
+        eof = true;
+      else
+        end += read;
+      continue;
+    }
+    // last line may have no line end
+    if (!line && begin == end) break;
+
+    size_t stop = line ? line - data : end;
+    string_view text(data + begin, stop - begin);
+    if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+    begin = line ? stop + 1 : end;
+
+    if (argc == 2) {
+      frame.set_arg(0, OBJECT_NUMBER, to_string(count));
+      frame.set_arg(1, OBJECT_STRING, text);
+    } else {
+      frame.set_arg(0, OBJECT_STRING, text);
+    }
+    delete frame.call();
+    ++count;
+  }
+  return number_result(count);
+}
+
 /**********************************************************************
  * Builtin functions registrations
  *********************************************************************/
 
 static vector<BuiltinTriplet> builtin_functions = {
-    BuiltinTriplet("dump_mem", new BuiltinBlock(builtin_dump_mem), {}),
-    BuiltinTriplet("for_each", new BuiltinBlock(builtin_for_each),
-                   {"arr", "for_each_func"}),
+    BuiltinTriplet("dump_mem", builtin_dump_mem, {}),
+    BuiltinTriplet("for_each", builtin_for_each, {"arr", "for_each_func"}),
+    BuiltinTriplet("map", builtin_map, {"arr", "map_func"}),
+    BuiltinTriplet("filter", builtin_filter, {"arr", "filter_func"}),
+    BuiltinTriplet("reduce", builtin_reduce, {"arr", "reduce_func", "init"}),
+    BuiltinTriplet("any", builtin_any, {"arr", "any_func"}),
+    BuiltinTriplet("all", builtin_all, {"arr", "all_func"}),
+    BuiltinTriplet("par_map", builtin_par_map, {"arr", "par_map_func"}),
+    BuiltinTriplet("par_for_each", builtin_par_for_each,
+                   {"arr", "par_for_each_func"}),
+    BuiltinTriplet("typed", builtin_typed, {"arr"}),
+    BuiltinTriplet("fill", builtin_fill, {"count", "value"}),
+    BuiltinTriplet("sum", builtin_sum, {"arr"}),
+    BuiltinTriplet("min", builtin_min, {"arr"}),
+    BuiltinTriplet("max", builtin_max, {"arr"}),
+    BuiltinTriplet("dot", builtin_dot, {"a", "b"}),
+    BuiltinTriplet("scale", builtin_scale, {"arr", "factor"}),
+    BuiltinTriplet("vec_add", builtin_vec_add, {"a", "b"}),
+    BuiltinTriplet("vec_mul", builtin_vec_mul, {"a", "b"}),
+    BuiltinTriplet("sort", builtin_sort, {"arr", "sort_func"}, 1),
+    BuiltinTriplet("bsearch", builtin_bsearch, {"arr", "x"}),
+    BuiltinTriplet("has", builtin_has, {"dict", "key"}),
+    BuiltinTriplet("get", builtin_get, {"dict", "key", "default"}, 1),
+    BuiltinTriplet("set", builtin_set, {"dict", "key", "value"}),
+    BuiltinTriplet("remove", builtin_remove, {"dict", "key"}),
+    BuiltinTriplet("keys", builtin_keys, {"dict"}),
+    BuiltinTriplet("len", builtin_len, {"value"}),
+    BuiltinTriplet("substr", builtin_substr, {"str", "start", "count"}, 1),
+    BuiltinTriplet("find", builtin_find, {"str", "needle", "from"}, 1),
+    BuiltinTriplet("split", builtin_split, {"str", "sep"}),
+    BuiltinTriplet("join", builtin_join, {"arr", "sep"}),
+    BuiltinTriplet("replace", builtin_replace, {"str", "from", "to"}),
+    BuiltinTriplet("upper", builtin_upper, {"str"}),
+    BuiltinTriplet("lower", builtin_lower, {"str"}),
+    BuiltinTriplet("load_f64", builtin_load_f64, {"path"}),
+    BuiltinTriplet("load_i32", builtin_load_i32, {"path"}),
+    BuiltinTriplet("store_f64", builtin_store_f64, {"path", "arr"}),
+    BuiltinTriplet("read_csv", builtin_read_csv, {"path", "row_func"}, 1),
+    BuiltinTriplet("json_parse", builtin_json_parse, {"str"}),
+    BuiltinTriplet("json_stringify", builtin_json_stringify, {"value"}),
+    BuiltinTriplet("lines", builtin_lines, {"line_func"}),
 };
 
 /**********************************************************************
@@ -80,3 +1517,20 @@ void BuiltinBlock::initialize_builtins(MemoryKernel& mem) {
     mem.put_object(new MemFunction(b.name, b.block, b.args));
   }
 }
+
+/**********************************************************************
+ * Call of builtin through memory (arguments are in current scope)
+ *********************************************************************/
+
+MemObject* BuiltinBlock::eval(MemoryKernel& mem) {
+  if (!native) return exec(mem);
+
+  vector<MemObject*> values;
+  for (Symbol param : params) values.push_back(mem.get_object(param));
+
+  MemObject* ret = native(mem, BuiltinArgs(values.data(), values.size()));
+
+  static const Symbol ret_name = intern("$ret");
+  if (ret) mem.put_global(ret->copy_as(ret_name));
+  return ret;
+}
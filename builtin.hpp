@@ -10,14 +10,66 @@ using namespace std;
 
 typedef MemObject* (*builtin_exec_t)(MemoryKernel& mem);
 
+/**
+ * @brief Evaluated arguments of native builtin
+ *        (view over caller's values, objects are not owned
+ *         and must not be modified, except dictionaries
+ *         changed in place by `set` and `remove`)
+ */
+class BuiltinArgs {
+  MemObject* const* values;
+  size_t count;
+
+ public:
+  BuiltinArgs(MemObject* const* values, size_t count)
+      : values(values), count(count) {}
+
+  size_t size() const { return count; }
+  MemObject* operator[](size_t i) const { return values[i]; }
+};
+
+/**
+ * Native builtin receives evaluated arguments directly, without
+ * scope and copies of arguments in memory. Returned object (or
+ * nullptr) is the result of call
+ */
+typedef MemObject* (*builtin_native_t)(MemoryKernel& mem, BuiltinArgs args);
+
 class BuiltinBlock : public AST::Block {
   builtin_exec_t exec;
+  builtin_native_t native;
+
+  // parameter names, used when native builtin is called through
+  // memory (e.g. as callback of other function)
+  vector<Symbol> params;
+
+  // number of trailing parameters which may be omitted in direct call
+  size_t optional;
 
  public:
-  BuiltinBlock(builtin_exec_t exec) : exec(exec) {}
-  MemObject* eval(MemoryKernel& mem) override { return exec(mem); }
+  BuiltinBlock(builtin_exec_t exec) : exec(exec), native(nullptr), optional(0) {}
+  BuiltinBlock(builtin_native_t native, vector<Symbol> params,
+               size_t optional = 0)
+      : exec(nullptr), native(native), params(params), optional(optional) {}
+
+  bool is_native() const { return native != nullptr; }
+
+  // number of arguments of native builtin
+  size_t arity() const { return params.size(); }
+
+  // native builtin can be called directly with `count` arguments
+  bool accepts(size_t count) const {
+    return count <= params.size() && count + optional >= params.size();
+  }
+
+  // direct call of native builtin
+  MemObject* call(MemoryKernel& mem, BuiltinArgs args) {
+    return native(mem, args);
+  }
+
+  MemObject* eval(MemoryKernel& mem) override;
 
   static void initialize_builtins(MemoryKernel& mem);
 };
 
-#endif /* __BUILTIN_HPP */
\ No newline at end of file
+#endif /* __BUILTIN_HPP */
@@ -0,0 +1,142 @@
+#include "csv.hpp"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/**************************************************
+ *           CsvReader Implementation
+ **************************************************/
+
+CsvReader::CsvReader(char delimiter)
+    : fd(-1), delimiter(delimiter), begin(0), end(0), eof(true), open_quote(false) {}
+
+CsvReader::~CsvReader() {
+  if (fd >= 0) close(fd);
+}
+
+bool CsvReader::open(const std::string &path) {
+  if (fd >= 0) close(fd);
+  fd = ::open(path.c_str(), O_RDONLY);
+  begin = end = 0;
+  eof = fd < 0;
+  open_quote = false;
+  if (fd < 0) return false;
+
+  buffer.resize(CHUNK_SIZE);
+  return true;
+}
+
+bool CsvReader::refill() {
+  if (eof) return false;
+
+  memmove(buffer.data(), buffer.data() + begin, end - begin);
+  end -= begin;
+  begin = 0;
+  // record longer than chunk
+  if (end == buffer.size()) buffer.resize(buffer.size() * 2);
+
+  ssize_t count = read(fd, buffer.data() + end, buffer.size() - end);
+  if (count <= 0) {
+    eof = true;
+    return false;
+  }
+  end += count;
+  return true;
+}
+
+void CsvReader::split(size_t from, size_t to,
+                      std::vector<std::string_view> &fields) {
+  if (to > from && buffer[to - 1] == '\r') --to;
+
+  const char *data = buffer.data();
+  while (true) {
+    const char *at = (const char *)memchr(data + from, delimiter, to - from);
+    if (!at) break;
+    fields.emplace_back(data + from, at - data - from);
+    from = at - data + 1;
+  }
+  fields.emplace_back(data + from, to - from);
+}
+
+bool CsvReader::parse_quoted(std::vector<std::string_view> &fields) {
+  unquoted.clear();
+  bounds.assign(1, 0);
+
+  size_t i = begin;
+  bool quoted = false;
+  while (true) {
+    if (i == end) {
+      // last record may have no line end (or closing quote)
+      if (!eof) return false;
+      break;
+    }
+
+    char c = buffer[i++];
+    if (quoted) {
+      if (c != '"') {
+        unquoted += c;
+      } else if (i < end && buffer[i] == '"') {
+        unquoted += '"';
+        ++i;
+      } else if (i == end && !eof) {
+        // can not tell escaped quote from closing one yet
+        return false;
+      } else {
+        quoted = false;
+      }
+    } else if (c == '"') {
+      quoted = true;
+    } else if (c == delimiter) {
+      bounds.push_back(unquoted.size());
+    } else if (c == '\n') {
+      break;
+    } else if (c != '\r') {
+      unquoted += c;
+    }
+  }
+
+  begin = i;
+  open_quote = quoted;
+  bounds.push_back(unquoted.size());
+  for (size_t f = 0; f + 1 < bounds.size(); ++f)
+    fields.emplace_back(unquoted.data() + bounds[f], bounds[f + 1] - bounds[f]);
+  return true;
+}
+
+bool CsvReader::next(std::vector<std::string_view> &fields) {
+  fields.clear();
+  open_quote = false;
+
+  while (true) {
+    const char *data = buffer.data();
+    const char *line = (const char *)memchr(data + begin, '\n', end - begin);
+    if (!line && !eof) {
+      refill();
+      continue;
+    }
+
+    size_t stop = line ? line - data : end;
+    if (stop == begin || (stop == begin + 1 && data[begin] == '\r')) {
+      // empty line (or nothing left)
+      if (!line) return false;
+      begin = stop + 1;
+      continue;
+    }
+
+    if (!memchr(data + begin, '"', stop - begin)) {
+      split(begin, stop, fields);
+      begin = line ? stop + 1 : end;
+      return true;
+    }
+
+    // quotes may hide delimiters and line ends
+    if (parse_quoted(fields)) return true;
+    fields.clear();
+    if (!refill()) {
+      // unterminated quote takes the rest of file (see `closed`)
+      return parse_quoted(fields);
+    }
+  }
+}
@@ -0,0 +1,71 @@
+#ifndef CSV_HPP
+#define CSV_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Streaming reader of CSV records
+ *
+ * File is read in big chunks, so memory does not depend on file
+ * size (only on the longest record). Records and fields are found
+ * by `memchr` (vectorized by libc), character loop is used only
+ * for records with quoted fields ("a,b" or "say ""hi"""), which
+ * may span several lines. Empty lines are skipped, "\r\n" line
+ * ends are accepted. Quote left open at the end of file ends the
+ * last record, `closed` tells about it.
+ */
+class CsvReader {
+ private:
+  int fd;
+  char delimiter;
+
+  // chunk of file, bytes [begin, end) are not parsed yet
+  std::vector<char> buffer;
+  size_t begin;
+  size_t end;
+  bool eof;
+  // last record ended inside quotes
+  bool open_quote;
+
+  // unescaped fields of quoted record
+  std::string unquoted;
+  std::vector<size_t> bounds;
+
+  // move unparsed bytes to the front and read more,
+  // false if nothing was read
+  bool refill();
+
+  // split record [from, to) without quotes into fields
+  void split(size_t from, size_t to, std::vector<std::string_view> &fields);
+
+  // parse quoted record starting at `begin`, false if it is not
+  // complete in buffer
+  bool parse_quoted(std::vector<std::string_view> &fields);
+
+ public:
+  static const size_t CHUNK_SIZE = 1 << 20;
+
+  explicit CsvReader(char delimiter = ',');
+  ~CsvReader();
+
+  CsvReader(const CsvReader &) = delete;
+  CsvReader &operator=(const CsvReader &) = delete;
+
+  // open file, false if it can not be read
+  bool open(const std::string &path);
+
+  /**
+   * @brief Read next record
+   *
+   * @param fields Receives fields of record (valid until next call)
+   * @return false at the end of file
+   */
+  bool next(std::vector<std::string_view> &fields);
+
+  // false if last record read ends inside quotes (at end of file)
+  bool closed() const { return !open_quote; }
+};
+
+#endif  // CSV_HPP
@@ -0,0 +1,151 @@
+#include "diagnostics.hpp"
+
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**************************************************
+ *                 Warnings Writer
+ **************************************************/
+
+namespace {
+
+/**
+ * Queue of warnings drained by background thread
+ * (created on first warning)
+ */
+class Writer {
+ private:
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable drained;
+  std::vector<std::string> queue;
+  bool busy = false;
+  bool stop = false;
+
+  std::unordered_set<const void *> sites;
+  std::unordered_set<Symbol> names;
+
+  DiagnosticsMode mode;
+  std::ofstream file;
+  std::thread worker;
+
+  void run() {
+    std::vector<std::string> batch;
+    std::unique_lock<std::mutex> guard(lock);
+
+    while (true) {
+      wake.wait(guard, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) break;
+
+      batch.swap(queue);
+      busy = true;
+      guard.unlock();
+
+      std::ostream &out = mode == DIAG_FILE ? file : std::cerr;
+      for (auto &text : batch) out << text;
+      out.flush();
+      batch.clear();
+
+      guard.lock();
+      busy = false;
+      drained.notify_all();
+    }
+  }
+
+ public:
+  Writer(DiagnosticsMode mode, const std::string &path) : mode(mode) {
+    if (mode == DIAG_FILE) file.open(path, std::ios_base::out);
+    worker = std::thread(&Writer::run, this);
+  }
+
+  ~Writer() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    wake.notify_one();
+    worker.join();
+  }
+
+  // queue text unless `site` (or `name`) was already reported
+  void push(const void *site, Symbol name, std::string text) {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      bool fresh = site ? sites.insert(site).second : names.insert(name).second;
+      if (!fresh) return;
+      queue.push_back(std::move(text));
+    }
+    wake.notify_one();
+  }
+
+  void flush() {
+    std::unique_lock<std::mutex> guard(lock);
+    drained.wait(guard, [this] { return queue.empty() && !busy; });
+  }
+};
+
+// function static, as diagnostics may be configured before
+// globals of this file are initialized
+std::string &writer_path() {
+  static std::string path = ".nnl_warn";
+  return path;
+}
+
+Writer &writer(DiagnosticsMode mode) {
+  static Writer instance(mode, writer_path());
+  return instance;
+}
+
+}  // namespace
+
+/**************************************************
+ *           Diagnostics Implementation
+ **************************************************/
+
+DiagnosticsMode Diagnostics::mode = DIAG_OFF;
+
+bool Diagnostics::analysed = false;
+
+void Diagnostics::configure(DiagnosticsMode mode, const std::string &path) {
+  Diagnostics::mode = mode;
+  writer_path() = path;
+}
+
+bool Diagnostics::parse_mode(const std::string &name, DiagnosticsMode &mode) {
+  if (name == "off")
+    mode = DIAG_OFF;
+  else if (name == "file")
+    mode = DIAG_FILE;
+  else if (name == "stderr")
+    mode = DIAG_STDERR;
+  else
+    return false;
+  return true;
+}
+
+void Diagnostics::report(const void *site, Symbol name, std::string text) {
+  writer(mode).push(site, name, std::move(text));
+}
+
+void Diagnostics::unused_variable(const void *site, Symbol name) {
+  if (!enabled()) return;
+  report(site, name, "Warning: variable " + symbol_name(name) +
+                         " was not used anywhere. You can remove it.\n");
+}
+
+void Diagnostics::unused_object(Symbol name) {
+  if (!enabled() || analysed || !name) return;
+  report(nullptr, name, "Warning: variable " + symbol_name(name) +
+                            " was not used anywhere. You can remove it.\n");
+}
+
+void Diagnostics::mark_analysed() { analysed = true; }
+
+void Diagnostics::flush() {
+  if (enabled()) writer(mode).flush();
+}
@@ -0,0 +1,84 @@
+#ifndef DIAGNOSTICS_HPP
+#define DIAGNOSTICS_HPP
+
+#include <string>
+
+#include "symbols.hpp"
+
+/**
+ * @brief Where diagnostics (warnings) are written
+ */
+enum DiagnosticsMode : int {
+  DIAG_OFF = 0,  // nothing is reported (default)
+  DIAG_FILE,     // warnings are written to file (.nnl_warn by default)
+  DIAG_STDERR,   // warnings are written to standard error
+};
+
+/**
+ * @brief Sink for interpreter warnings
+ *
+ * Warnings are queued and written by background thread in
+ * batches, so reporting never waits for I/O. Each warning is
+ * reported once per declaration site (or once per name, when site
+ * is unknown). When diagnostics are off nothing is queued and
+ * no thread or file is created.
+ *
+ * Unused variables of a script are found statically (see
+ * `AST::report_unused`), after that objects destroyed at runtime
+ * are not checked anymore. Runtime check is left for programs
+ * which use MemoryKernel directly.
+ */
+class Diagnostics {
+ private:
+  static DiagnosticsMode mode;
+
+  // set once variables were analysed statically
+  static bool analysed;
+
+  // queue warning, deduplicated by `site` or by `name` if site is null
+  static void report(const void *site, Symbol name, std::string text);
+
+ public:
+  /**
+   * @brief Select where warnings go
+   *
+   * @param mode Diagnostics mode
+   * @param path File for DIAG_FILE mode
+   */
+  static void configure(DiagnosticsMode mode,
+                        const std::string &path = ".nnl_warn");
+
+  /**
+   * @brief Parse mode name ("off", "file" or "stderr")
+   *
+   * @return false if name is unknown
+   */
+  static bool parse_mode(const std::string &name, DiagnosticsMode &mode);
+
+  // checked before any work related to diagnostics
+  static bool enabled() { return mode != DIAG_OFF; }
+
+  /**
+   * @brief Report variable which is never read
+   *
+   * @param site Declaration site (node of declaration)
+   * @param name Name of variable
+   */
+  static void unused_variable(const void *site, Symbol name);
+
+  /**
+   * @brief Report object destroyed without references
+   *        (ignored after static analysis)
+   *
+   * @param name Name of object
+   */
+  static void unused_object(Symbol name);
+
+  // mark that unused variables are computed statically
+  static void mark_analysed();
+
+  // wait until queued warnings are written
+  static void flush();
+};
+
+#endif  // DIAGNOSTICS_HPP
@@ -0,0 +1,63 @@
+#include "json.hpp"
+
+#include <charconv>
+#include <cmath>
+
+/**************************************************
+ *           JsonWriter Implementation
+ **************************************************/
+
+void JsonWriter::text(std::string_view value) {
+  static const char hex[] = "0123456789abcdef";
+
+  out += '"';
+  size_t start = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    unsigned char c = value[i];
+    if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+    out.append(value.data() + start, i - start);
+    start = i + 1;
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        out += "\\u00";
+        out += hex[c >> 4];
+        out += hex[c & 15];
+    }
+  }
+  out.append(value.data() + start, value.size() - start);
+  out += '"';
+}
+
+void JsonWriter::number(double value) {
+  if (!std::isfinite(value)) {
+    out += "null";
+    return;
+  }
+
+  char buffer[32];
+  std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+
+void JsonWriter::integer(long long value) {
+  char buffer[32];
+  std::to_chars_result result =
+      std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+
+std::string JsonWriter::quote(std::string_view value) {
+  std::string result;
+  result.reserve(value.size() + 2);
+  JsonWriter(result).text(value);
+  return result;
+}
@@ -0,0 +1,36 @@
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Writer of JSON text into string
+ *
+ * Text is appended to one growing string (no streams). Strings are
+ * copied by spans between characters which need escapes, numbers
+ * are written by `std::to_chars` in shortest form.
+ */
+class JsonWriter {
+ private:
+  std::string &out;
+
+ public:
+  explicit JsonWriter(std::string &out) : out(out) {}
+
+  // quoted and escaped string
+  void text(std::string_view value);
+
+  // number, JSON has no nan and infinities, so they are written as null
+  void number(double value);
+  void integer(long long value);
+
+  // text which is JSON already (punctuation, literals)
+  void raw(std::string_view json) { out += json; }
+  void raw(char c) { out += c; }
+
+  // quoted and escaped copy of string
+  static std::string quote(std::string_view value);
+};
+
+#endif  // JSON_HPP
@@ -7,6 +7,8 @@
 #include "parser.tab.hpp"
 #include "ast.hpp"
 #include "builtin.hpp"
+#include "diagnostics.hpp"
+#include "numbers.hpp"
 
 enum TokenType : int {
     EOF_ = 0,
@@ -60,6 +62,9 @@ enum TokenType : int {
     AND,
     OR,
     XOR,
+    COLON,
+    INTERP_BEGIN,
+    INTERP_END,
 };
 
 const string TokenTypeStr[] = {
@@ -114,13 +119,18 @@ const string TokenTypeStr[] = {
     [TokenType::AND] = "AND",
     [TokenType::OR] = "OR",
     [TokenType::XOR] = "XOR",
+    [TokenType::COLON] = "COLON",
+    [TokenType::INTERP_BEGIN] = "INTERP_BEGIN",
+    [TokenType::INTERP_END] = "INTERP_END",
 };
 
 class Token {
     public:
-        Token(TokenType type, string lexeme, size_t line) : type(type), lexeme(lexeme), line(line) {}
+        // identifiers are interned once here, parser and AST work with symbols
+        Token(TokenType type, string lexeme, size_t line) : type(type), lexeme(lexeme), line(line),
+            symbol(type == TokenType::IDENTIFIER ? intern(lexeme) : 0) {}
 
-        Token(TokenType type, string lexeme) : type(type), lexeme(lexeme) {}
+        Token(TokenType type, string lexeme) : Token(type, lexeme, 0) {}
 
         TokenType getType() const { return type; }
 
@@ -128,10 +138,13 @@ class Token {
 
         size_t getLine() const { return line; }
 
+        Symbol getSymbol() const { return symbol; }
+
     private:
         TokenType type;
         string lexeme;
         size_t line;
+        Symbol symbol;
 };
 
 class Lexer {
@@ -159,7 +172,10 @@ class Lexer {
                     tokens.emplace_back(TokenType::NUMBER, number, curentLine);
                 } else if (c == '"') {
                     string str = readString(i);
-                    tokens.emplace_back(TokenType::STRING, str, curentLine);
+                    if (str.find_first_of("{}") != string::npos)
+                        readInterpolation(str, curentLine, tokens);
+                    else
+                        tokens.emplace_back(TokenType::STRING, str, curentLine);
                 } else if (c == '#') {
                     skipComment(i, curentLine);
                 } else if (c == ',') {
@@ -233,6 +249,9 @@ class Lexer {
                 } else if (c == '.') {
                     tokens.emplace_back(TokenType::DOT_OP, ".", curentLine);
                     i++;
+                } else if (c == ':') {
+                    tokens.emplace_back(TokenType::COLON, ":", curentLine);
+                    i++;
                 } else {
                     tokens.emplace_back(TokenType::INVALID, string(1, c), curentLine);
                     i++;
@@ -248,7 +267,8 @@ class Lexer {
 
         string readIdentifier(size_t& i) {
             size_t start = i;
-            regex pattern("[a-zA-Z_]");
+            // digits may follow the first character (e.g. load_f64)
+            regex pattern("[a-zA-Z_0-9]");
             
             while (i < input.length() && regex_match(string(1, input[i]), pattern)) {
                 i++;
@@ -282,6 +302,55 @@ class Lexer {
             return input.substr(start, i - start - 1);
         }
 
+        /**
+         * String with embedded expressions, e.g. "[{i}] {val}",
+         * becomes INTERP_BEGIN, text parts (STRING) and expressions
+         * (in LBRACE ... RBRACE), INTERP_END. "{{" and "}}" are
+         * literal braces. Embedded expressions can not contain
+         * string literals
+         */
+        void readInterpolation(const string& str, size_t line, vector<Token>& tokens) {
+            tokens.emplace_back(TokenType::INTERP_BEGIN, "\"", line);
+            string text;
+            size_t k = 0;
+            while (k < str.length()) {
+                bool doubled = k + 1 < str.length() && str[k + 1] == str[k];
+                if ((str[k] == '{' || str[k] == '}') && doubled) {
+                    text += str[k];
+                    k += 2;
+                } else if (str[k] == '{') {
+                    // matching brace (expression may have tuple or dict inside)
+                    size_t end = k + 1;
+                    for (int depth = 1; end < str.length(); end++) {
+                        if (str[end] == '{') depth++;
+                        if (str[end] == '}' && --depth == 0) break;
+                    }
+                    if (end == str.length()) {
+                        tokens.emplace_back(TokenType::INVALID, str.substr(k), line);
+                        break;
+                    }
+
+                    if (!text.empty()) tokens.emplace_back(TokenType::STRING, text, line);
+                    text.clear();
+
+                    tokens.emplace_back(TokenType::LBRACE, "{", line);
+                    vector<Token> inner = Lexer(str.substr(k + 1, end - k - 1)).tokenize();
+                    inner.pop_back(); // EOF_
+                    for (Token& token : inner)
+                        tokens.emplace_back(token.getType(), token.getLexeme(), line);
+                    tokens.emplace_back(TokenType::RBRACE, "}", line);
+                    k = end + 1;
+                } else if (str[k] == '}') {
+                    // single closing brace has no opening one
+                    tokens.emplace_back(TokenType::INVALID, str.substr(k), line);
+                    break;
+                } else {
+                    text += str[k++];
+                }
+            }
+            if (!text.empty()) tokens.emplace_back(TokenType::STRING, text, line);
+            tokens.emplace_back(TokenType::INTERP_END, "\"", line);
+        }
 
         void skipComment(size_t& i, size_t& line){
             while (i < input.length()) {
@@ -356,6 +425,9 @@ class Lexer {
 
 vector<Token> tokens;
 int idx = 0;
+// lines of function calls being parsed (name followed by '('),
+// calls are nested, so parser takes them from the back
+vector<size_t> call_lines;
 
 yy::parser::symbol_type get_next_token() {
     const Token& token = tokens[idx];
@@ -364,7 +436,9 @@ yy::parser::symbol_type get_next_token() {
     idx++;
     switch (type) {
         case TokenType::IDENTIFIER:
-            return yy::parser::make_IDENTIFIER(token.getLexeme());
+            if (idx < (int)tokens.size() && tokens[idx].getType() == TokenType::LPAREN)
+                call_lines.push_back(token.getLine());
+            return yy::parser::make_IDENTIFIER(token.getSymbol());
             break;
     
         case TokenType::NUMBER:
@@ -565,6 +639,18 @@ yy::parser::symbol_type get_next_token() {
             return yy::parser::make_XOR();
             break;
 
+        case TokenType::COLON:
+            return yy::parser::make_COLON();
+            break;
+
+        case TokenType::INTERP_BEGIN:
+            return yy::parser::make_INTERP_BEGIN();
+            break;
+
+        case TokenType::INTERP_END:
+            return yy::parser::make_INTERP_END();
+            break;
+
         case TokenType::EOF_:
             return yy::parser::make_EOF_();
             break;
@@ -576,12 +662,38 @@ yy::parser::symbol_type get_next_token() {
 }
 
 int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        cerr << "Usage: " << argv[0] << " FILENAME\n";
-        return 1;
+    string filename;
+    DiagnosticsMode warnings = DIAG_OFF;
+    NumberStyle numbers = NUMBERS_FIXED;
+    bool inline_stats = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg(argv[i]);
+        if (arg.rfind("--warnings=", 0) == 0) {
+            if (!Diagnostics::parse_mode(arg.substr(11), warnings)) {
+                cerr << "Unknown warnings mode: " << arg.substr(11) << "\n";
+                return 1;
+            }
+        } else if (arg.rfind("--numbers=", 0) == 0) {
+            if (!NumberFormat::parse_style(arg.substr(10), numbers)) {
+                cerr << "Unknown numbers style: " << arg.substr(10) << "\n";
+                return 1;
+            }
+        } else if (arg == "--inline-stats") {
+            inline_stats = true;
+        } else {
+            filename = arg;
+        }
     }
 
-    string filename(argv[1]);
+    if (filename.empty()) {
+        cerr << "Usage: " << argv[0]
+             << " [--warnings=off|file|stderr] [--numbers=fixed|shortest] [--inline-stats] FILENAME\n";
+        return 1;
+    }
+    Diagnostics::configure(warnings);
+    NumberFormat::configure(numbers);
+    if (inline_stats) AST::enable_inline_stats();
 
     ifstream file(filename);
     if (!file.good()) {
@@ -606,19 +718,22 @@ int main(int argc, char *argv[]) {
 
     Lexer lexer(input);
     tokens = lexer.tokenize();
-    AST::ASTNode* ast_root;
+    AST::ASTNode* ast_root = nullptr;
 
     yy::parser p(&ast_root);
-    p.parse();
+    if (p.parse() != 0 || !ast_root) return 1;
 
 #ifdef DEBUG
     cout << ast_root->str() << '\n';
 #endif /* DEBUG */
 
+    AST::report_unused(ast_root);
+
     MemoryKernel mem;
     BuiltinBlock::initialize_builtins(mem);
     
     ast_root->eval(mem);
+    AST::report_inlining(cerr);
     return 0;
 }
 
@@ -0,0 +1,99 @@
+#include "numbers.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+/**************************************************
+ *           NumberFormat Implementation
+ **************************************************/
+
+NumberStyle NumberFormat::style = NUMBERS_FIXED;
+
+void NumberFormat::configure(NumberStyle style) { NumberFormat::style = style; }
+
+bool NumberFormat::parse_style(const std::string &name, NumberStyle &style) {
+  if (name == "fixed")
+    style = NUMBERS_FIXED;
+  else if (name == "shortest")
+    style = NUMBERS_SHORTEST;
+  else
+    return false;
+  return true;
+}
+
+std::string NumberFormat::format(double value) {
+  // whole numbers within long long have the same text as integers
+  // (-0 is not whole here, it keeps its sign)
+  if (value >= -9.2e18 && value <= 9.2e18 && value == (long long)value &&
+      (value != 0 || !std::signbit(value)))
+    return format_integer((long long)value);
+
+  // enough for fixed form of the biggest double
+  char buffer[512];
+  std::to_chars_result result =
+      style == NUMBERS_SHORTEST
+          ? std::to_chars(buffer, buffer + sizeof(buffer), value)
+          : std::to_chars(buffer, buffer + sizeof(buffer), value,
+                          std::chars_format::fixed, 6);
+  return std::string(buffer, result.ptr);
+}
+
+std::string NumberFormat::format_integer(long long value) {
+  char buffer[32];
+  char *end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+  if (style == NUMBERS_FIXED) {
+    memcpy(end, ".000000", 7);
+    end += 7;
+  }
+  return std::string(buffer, end);
+}
+
+double NumberFormat::parse(std::string_view text) {
+  size_t start = 0;
+  while (start < text.size() && isspace((unsigned char)text[start])) ++start;
+  if (start < text.size() && text[start] == '+') ++start;
+
+  double value = 0;
+  const char *begin = text.data() + start, *end = text.data() + text.size();
+  std::from_chars_result result = std::from_chars(begin, end, value);
+
+  // too big or too small number is rounded as strtod does
+  if (result.ec == std::errc::result_out_of_range)
+    value = strtod(std::string(begin, end).c_str(), nullptr);
+  return result.ec == std::errc::invalid_argument ? 0 : value;
+}
+
+bool NumberFormat::parse_exact(std::string_view text, double &value) {
+  size_t start = 0, stop = text.size();
+  while (start < stop && isspace((unsigned char)text[start])) ++start;
+  while (stop > start && isspace((unsigned char)text[stop - 1])) --stop;
+  if (start < stop && text[start] == '+') ++start;
+
+  const char *begin = text.data() + start, *end = text.data() + stop;
+  std::from_chars_result result = std::from_chars(begin, end, value);
+  if (result.ptr != end || begin == end) return false;
+
+  if (result.ec == std::errc::result_out_of_range)
+    value = strtod(std::string(begin, end).c_str(), nullptr);
+  return result.ec != std::errc::invalid_argument;
+}
+
+bool NumberFormat::parse_integer(std::string_view text, long long &value) {
+  const char *begin = text.data(), *end = text.data() + text.size();
+  if (begin != end && *begin == '+') ++begin;
+
+  std::from_chars_result result = std::from_chars(begin, end, value);
+  if (result.ec != std::errc() || result.ptr == begin) return false;
+  // negative zero is kept by floating point
+  if (value == 0 && *begin == '-') return false;
+
+  // only zeros may follow the point
+  const char *rest = result.ptr;
+  if (rest == end) return true;
+  if (*rest++ != '.') return false;
+  while (rest != end && *rest == '0') ++rest;
+  return rest == end;
+}
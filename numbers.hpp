@@ -0,0 +1,76 @@
+#ifndef NUMBERS_HPP
+#define NUMBERS_HPP
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief How numbers are written into values
+ */
+enum NumberStyle : int {
+  NUMBERS_FIXED = 0,  // six digits after point, e.g. 38.000000 (default)
+  NUMBERS_SHORTEST,   // shortest text which reads back to the same
+                      // number, e.g. 38 or 0.1
+};
+
+/**
+ * @brief Conversions between numbers and their text
+ *
+ * Values of number objects are kept as text, so every arithmetic
+ * result is formatted and every operand is parsed (once, see
+ * `MemObject::get_number`). Both directions use `std::to_chars`
+ * and `std::from_chars`: no locale, no streams and no allocation
+ * besides the resulting string.
+ */
+class NumberFormat {
+ private:
+  static NumberStyle style;
+
+ public:
+  // select style of formatted numbers
+  static void configure(NumberStyle style);
+
+  /**
+   * @brief Parse style name ("fixed" or "shortest")
+   *
+   * @return false if name is unknown
+   */
+  static bool parse_style(const std::string &name, NumberStyle &style);
+
+  // text of every number reads back to the same number
+  // (fixed style rounds fractions)
+  static bool exact() { return style == NUMBERS_SHORTEST; }
+
+  // text of number in current style
+  // (whole numbers are written as integers, see `format_integer`)
+  static std::string format(double value);
+
+  // text of integer in current style, e.g. 38.000000 or 38
+  static std::string format_integer(long long value);
+
+  /**
+   * @brief Number at the beginning of text (as stream would read it:
+   *        leading spaces and '+' are skipped, rest of text is ignored)
+   *
+   * @return parsed number or 0 if text does not start with number
+   */
+  static double parse(std::string_view text);
+
+  /**
+   * @brief Parse text which is a number as a whole
+   *        (surrounding spaces and leading '+' are allowed)
+   *
+   * @return false if text is not a number
+   */
+  static bool parse_exact(std::string_view text, double &value);
+
+  /**
+   * @brief Parse text of whole number (e.g. "38", "-7" or "38.000000")
+   *        exactly, without floating point
+   *
+   * @return false if text is not a whole number within long long
+   */
+  static bool parse_integer(std::string_view text, long long &value);
+};
+
+#endif  // NUMBERS_HPP
@@ -0,0 +1,2090 @@
+// A Bison parser, made by GNU Bison 3.8.2.
+
+// Skeleton implementation for Bison LALR(1) parsers in C++
+
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// As a special exception, you may create a larger work that contains
+// part or all of the Bison parser skeleton and distribute that work
+// under terms of your choice, so long as that work isn't itself a
+// parser generator using the skeleton or a modified version thereof
+// as a parser skeleton.  Alternatively, if you modify or redistribute
+// the parser skeleton itself, you may (at your option) remove this
+// special exception, which will cause the skeleton and the resulting
+// Bison output files to be licensed under the GNU General Public
+// License without this special exception.
+
+// This special exception was added by the Free Software Foundation in
+// version 2.2 of Bison.
+
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
+
+
+
+
+
+#include "parser.tab.hpp"
+
+
+// Unqualified %code blocks.
+#line 26 "/root/repo/parser.ypp"
+
+    namespace yy
+    {
+        parser::symbol_type yylex(); // override (2)
+        // no need to override the error function because it is already waiting for our implementation (3)
+    }
+	void dump(AST::ASTNode* n);
+
+    extern yy::parser::symbol_type get_next_token();
+    extern std::vector<size_t> call_lines;
+
+#line 58 "/root/repo/parser.tab.cpp"
+
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> // FIXME: INFRINGES ON USER NAME SPACE.
+#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(msgid) msgid
+# endif
+#endif
+
+
+// Whether we are compiled with exception support.
+#ifndef YY_EXCEPTIONS
+# if defined __GNUC__ && !defined __EXCEPTIONS
+#  define YY_EXCEPTIONS 0
+# else
+#  define YY_EXCEPTIONS 1
+# endif
+#endif
+
+
+
+// Enable debugging if requested.
+#if YYDEBUG
+
+// A pseudo ostream that takes yydebug_ into account.
+# define YYCDEBUG if (yydebug_) (*yycdebug_)
+
+# define YY_SYMBOL_PRINT(Title, Symbol)         \
+  do {                                          \
+    if (yydebug_)                               \
+    {                                           \
+      *yycdebug_ << Title << ' ';               \
+      yy_print_ (*yycdebug_, Symbol);           \
+      *yycdebug_ << '\n';                       \
+    }                                           \
+  } while (false)
+
+# define YY_REDUCE_PRINT(Rule)          \
+  do {                                  \
+    if (yydebug_)                       \
+      yy_reduce_print_ (Rule);          \
+  } while (false)
+
+# define YY_STACK_PRINT()               \
+  do {                                  \
+    if (yydebug_)                       \
+      yy_stack_print_ ();                \
+  } while (false)
+
+#else // !YYDEBUG
+
+# define YYCDEBUG if (false) std::cerr
+# define YY_SYMBOL_PRINT(Title, Symbol)  YY_USE (Symbol)
+# define YY_REDUCE_PRINT(Rule)           static_cast<void> (0)
+# define YY_STACK_PRINT()                static_cast<void> (0)
+
+#endif // !YYDEBUG
+
+#define yyerrok         (yyerrstatus_ = 0)
+#define yyclearin       (yyla.clear ())
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYRECOVERING()  (!!yyerrstatus_)
+
+namespace yy {
+#line 131 "/root/repo/parser.tab.cpp"
+
+  /// Build a parser object.
+  parser::parser (AST::ASTNode** ast_root_yyarg)
+#if YYDEBUG
+    : yydebug_ (false),
+      yycdebug_ (&std::cerr),
+#else
+    :
+#endif
+      ast_root (ast_root_yyarg)
+  {}
+
+  parser::~parser ()
+  {}
+
+  parser::syntax_error::~syntax_error () YY_NOEXCEPT YY_NOTHROW
+  {}
+
+  /*---------.
+  | symbol.  |
+  `---------*/
+
+
+
+  // by_state.
+  parser::by_state::by_state () YY_NOEXCEPT
+    : state (empty_state)
+  {}
+
+  parser::by_state::by_state (const by_state& that) YY_NOEXCEPT
+    : state (that.state)
+  {}
+
+  void
+  parser::by_state::clear () YY_NOEXCEPT
+  {
+    state = empty_state;
+  }
+
+  void
+  parser::by_state::move (by_state& that)
+  {
+    state = that.state;
+    that.clear ();
+  }
+
+  parser::by_state::by_state (state_type s) YY_NOEXCEPT
+    : state (s)
+  {}
+
+  parser::symbol_kind_type
+  parser::by_state::kind () const YY_NOEXCEPT
+  {
+    if (state == empty_state)
+      return symbol_kind::S_YYEMPTY;
+    else
+      return YY_CAST (symbol_kind_type, yystos_[+state]);
+  }
+
+  parser::stack_symbol_type::stack_symbol_type ()
+  {}
+
+  parser::stack_symbol_type::stack_symbol_type (YY_RVREF (stack_symbol_type) that)
+    : super_type (YY_MOVE (that.state))
+  {
+    switch (that.kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.YY_MOVE_OR_COPY< AST::ASTNode* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.YY_MOVE_OR_COPY< AST::AssignMod* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.YY_MOVE_OR_COPY< AST::Block* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.YY_MOVE_OR_COPY< AST::DictDecl* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.YY_MOVE_OR_COPY< AST::Interpolation* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.YY_MOVE_OR_COPY< Symbol > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.YY_MOVE_OR_COPY< string > (YY_MOVE (that.value));
+        break;
+
+      default:
+        break;
+    }
+
+#if 201103L <= YY_CPLUSPLUS
+    // that is emptied.
+    that.state = empty_state;
+#endif
+  }
+
+  parser::stack_symbol_type::stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) that)
+    : super_type (s)
+  {
+    switch (that.kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.move< AST::ASTNode* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.move< AST::AssignMod* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.move< AST::Block* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.move< AST::DictDecl* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.move< AST::Interpolation* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.move< Symbol > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.move< string > (YY_MOVE (that.value));
+        break;
+
+      default:
+        break;
+    }
+
+    // that is emptied.
+    that.kind_ = symbol_kind::S_YYEMPTY;
+  }
+
+#if YY_CPLUSPLUS < 201103L
+  parser::stack_symbol_type&
+  parser::stack_symbol_type::operator= (const stack_symbol_type& that)
+  {
+    state = that.state;
+    switch (that.kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.copy< AST::ASTNode* > (that.value);
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.copy< AST::AssignMod* > (that.value);
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.copy< AST::Block* > (that.value);
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.copy< AST::DictDecl* > (that.value);
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.copy< AST::Interpolation* > (that.value);
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.copy< Symbol > (that.value);
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.copy< string > (that.value);
+        break;
+
+      default:
+        break;
+    }
+
+    return *this;
+  }
+
+  parser::stack_symbol_type&
+  parser::stack_symbol_type::operator= (stack_symbol_type& that)
+  {
+    state = that.state;
+    switch (that.kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.move< AST::ASTNode* > (that.value);
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.move< AST::AssignMod* > (that.value);
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.move< AST::Block* > (that.value);
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.move< AST::DictDecl* > (that.value);
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.move< AST::Interpolation* > (that.value);
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.move< Symbol > (that.value);
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.move< string > (that.value);
+        break;
+
+      default:
+        break;
+    }
+
+    // that is emptied.
+    that.state = empty_state;
+    return *this;
+  }
+#endif
+
+  template <typename Base>
+  void
+  parser::yy_destroy_ (const char* yymsg, basic_symbol<Base>& yysym) const
+  {
+    if (yymsg)
+      YY_SYMBOL_PRINT (yymsg, yysym);
+  }
+
+#if YYDEBUG
+  template <typename Base>
+  void
+  parser::yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const
+  {
+    std::ostream& yyoutput = yyo;
+    YY_USE (yyoutput);
+    if (yysym.empty ())
+      yyo << "empty symbol";
+    else
+      {
+        symbol_kind_type yykind = yysym.kind ();
+        yyo << (yykind < YYNTOKENS ? "token" : "nterm")
+            << ' ' << yysym.name () << " (";
+        YY_USE (yykind);
+        yyo << ')';
+      }
+  }
+#endif
+
+  void
+  parser::yypush_ (const char* m, YY_MOVE_REF (stack_symbol_type) sym)
+  {
+    if (m)
+      YY_SYMBOL_PRINT (m, sym);
+    yystack_.push (YY_MOVE (sym));
+  }
+
+  void
+  parser::yypush_ (const char* m, state_type s, YY_MOVE_REF (symbol_type) sym)
+  {
+#if 201103L <= YY_CPLUSPLUS
+    yypush_ (m, stack_symbol_type (s, std::move (sym)));
+#else
+    stack_symbol_type ss (s, sym);
+    yypush_ (m, ss);
+#endif
+  }
+
+  void
+  parser::yypop_ (int n) YY_NOEXCEPT
+  {
+    yystack_.pop (n);
+  }
+
+#if YYDEBUG
+  std::ostream&
+  parser::debug_stream () const
+  {
+    return *yycdebug_;
+  }
+
+  void
+  parser::set_debug_stream (std::ostream& o)
+  {
+    yycdebug_ = &o;
+  }
+
+
+  parser::debug_level_type
+  parser::debug_level () const
+  {
+    return yydebug_;
+  }
+
+  void
+  parser::set_debug_level (debug_level_type l)
+  {
+    yydebug_ = l;
+  }
+#endif // YYDEBUG
+
+  parser::state_type
+  parser::yy_lr_goto_state_ (state_type yystate, int yysym)
+  {
+    int yyr = yypgoto_[yysym - YYNTOKENS] + yystate;
+    if (0 <= yyr && yyr <= yylast_ && yycheck_[yyr] == yystate)
+      return yytable_[yyr];
+    else
+      return yydefgoto_[yysym - YYNTOKENS];
+  }
+
+  bool
+  parser::yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT
+  {
+    return yyvalue == yypact_ninf_;
+  }
+
+  bool
+  parser::yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT
+  {
+    return yyvalue == yytable_ninf_;
+  }
+
+  int
+  parser::operator() ()
+  {
+    return parse ();
+  }
+
+  int
+  parser::parse ()
+  {
+    int yyn;
+    /// Length of the RHS of the rule being reduced.
+    int yylen = 0;
+
+    // Error handling.
+    int yynerrs_ = 0;
+    int yyerrstatus_ = 0;
+
+    /// The lookahead symbol.
+    symbol_type yyla;
+
+    /// The return value of parse ().
+    int yyresult;
+
+#if YY_EXCEPTIONS
+    try
+#endif // YY_EXCEPTIONS
+      {
+    YYCDEBUG << "Starting parse\n";
+
+
+    /* Initialize the stack.  The initial state will be set in
+       yynewstate, since the latter expects the semantical and the
+       location values to have been already stored, initialize these
+       stacks with a primary value.  */
+    yystack_.clear ();
+    yypush_ (YY_NULLPTR, 0, YY_MOVE (yyla));
+
+  /*-----------------------------------------------.
+  | yynewstate -- push a new symbol on the stack.  |
+  `-----------------------------------------------*/
+  yynewstate:
+    YYCDEBUG << "Entering state " << int (yystack_[0].state) << '\n';
+    YY_STACK_PRINT ();
+
+    // Accept?
+    if (yystack_[0].state == yyfinal_)
+      YYACCEPT;
+
+    goto yybackup;
+
+
+  /*-----------.
+  | yybackup.  |
+  `-----------*/
+  yybackup:
+    // Try to take a decision without lookahead.
+    yyn = yypact_[+yystack_[0].state];
+    if (yy_pact_value_is_default_ (yyn))
+      goto yydefault;
+
+    // Read a lookahead token.
+    if (yyla.empty ())
+      {
+        YYCDEBUG << "Reading a token\n";
+#if YY_EXCEPTIONS
+        try
+#endif // YY_EXCEPTIONS
+          {
+            symbol_type yylookahead (yylex ());
+            yyla.move (yylookahead);
+          }
+#if YY_EXCEPTIONS
+        catch (const syntax_error& yyexc)
+          {
+            YYCDEBUG << "Caught exception: " << yyexc.what() << '\n';
+            error (yyexc);
+            goto yyerrlab1;
+          }
+#endif // YY_EXCEPTIONS
+      }
+    YY_SYMBOL_PRINT ("Next token is", yyla);
+
+    if (yyla.kind () == symbol_kind::S_YYerror)
+    {
+      // The scanner already issued an error message, process directly
+      // to error recovery.  But do not keep the error token as
+      // lookahead, it is too special and may lead us to an endless
+      // loop in error recovery. */
+      yyla.kind_ = symbol_kind::S_YYUNDEF;
+      goto yyerrlab1;
+    }
+
+    /* If the proper action on seeing token YYLA.TYPE is to reduce or
+       to detect an error, take that action.  */
+    yyn += yyla.kind ();
+    if (yyn < 0 || yylast_ < yyn || yycheck_[yyn] != yyla.kind ())
+      {
+        goto yydefault;
+      }
+
+    // Reduce or error.
+    yyn = yytable_[yyn];
+    if (yyn <= 0)
+      {
+        if (yy_table_value_is_error_ (yyn))
+          goto yyerrlab;
+        yyn = -yyn;
+        goto yyreduce;
+      }
+
+    // Count tokens shifted since error; after three, turn off error status.
+    if (yyerrstatus_)
+      --yyerrstatus_;
+
+    // Shift the lookahead token.
+    yypush_ ("Shifting", state_type (yyn), YY_MOVE (yyla));
+    goto yynewstate;
+
+
+  /*-----------------------------------------------------------.
+  | yydefault -- do the default action for the current state.  |
+  `-----------------------------------------------------------*/
+  yydefault:
+    yyn = yydefact_[+yystack_[0].state];
+    if (yyn == 0)
+      goto yyerrlab;
+    goto yyreduce;
+
+
+  /*-----------------------------.
+  | yyreduce -- do a reduction.  |
+  `-----------------------------*/
+  yyreduce:
+    yylen = yyr2_[yyn];
+    {
+      stack_symbol_type yylhs;
+      yylhs.state = yy_lr_goto_state_ (yystack_[yylen].state, yyr1_[yyn]);
+      /* Variants are always initialized to an empty instance of the
+         correct type. The default '$$ = $1' action is NOT applied
+         when using variants.  */
+      switch (yyr1_[yyn])
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        yylhs.value.emplace< AST::ASTNode* > ();
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        yylhs.value.emplace< AST::AssignMod* > ();
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        yylhs.value.emplace< AST::Block* > ();
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        yylhs.value.emplace< AST::DictDecl* > ();
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        yylhs.value.emplace< AST::Interpolation* > ();
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        yylhs.value.emplace< Symbol > ();
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        yylhs.value.emplace< string > ();
+        break;
+
+      default:
+        break;
+    }
+
+
+
+      // Perform the reduction.
+      YY_REDUCE_PRINT (yyn);
+#if YY_EXCEPTIONS
+      try
+#endif // YY_EXCEPTIONS
+        {
+          switch (yyn)
+            {
+  case 2: // program: block
+#line 113 "/root/repo/parser.ypp"
+                { *ast_root = yystack_[0].value.as < AST::Block* > (); }
+#line 778 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 3: // block: statement
+#line 117 "/root/repo/parser.ypp"
+                    {
+		yylhs.value.as < AST::Block* > () = new AST::Block();
+		if (dynamic_cast<AST::Block*>(yystack_[0].value.as < AST::ASTNode* > ())) {
+			AST::Block* list = dynamic_cast<AST::Block*>(yystack_[0].value.as < AST::ASTNode* > ());
+			yylhs.value.as < AST::Block* > ()->flat(list);
+		} else {
+			yylhs.value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ());
+		}
+	}
+#line 792 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 4: // block: operation
+#line 126 "/root/repo/parser.ypp"
+                    { yylhs.value.as < AST::Block* > () = new AST::Block(); yylhs.value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 798 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 5: // block: block statement
+#line 127 "/root/repo/parser.ypp"
+                          {
+		if (dynamic_cast<AST::Block*>(yystack_[0].value.as < AST::ASTNode* > ())) {
+			AST::Block* list = dynamic_cast<AST::Block*>(yystack_[0].value.as < AST::ASTNode* > ());
+			yystack_[1].value.as < AST::Block* > ()->flat(list);
+		} else {
+			yystack_[1].value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ());
+		}
+		yylhs.value.as < AST::Block* > () = yystack_[1].value.as < AST::Block* > ();
+	}
+#line 812 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 6: // block: block operation
+#line 136 "/root/repo/parser.ypp"
+                          { yystack_[1].value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ()); yylhs.value.as < AST::Block* > () = yystack_[1].value.as < AST::Block* > (); }
+#line 818 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 7: // block: return
+#line 137 "/root/repo/parser.ypp"
+                 {
+		yylhs.value.as < AST::Block* > () = new AST::Block(); yylhs.value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 826 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 8: // block: block return
+#line 140 "/root/repo/parser.ypp"
+                       {
+		yystack_[1].value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ()); yylhs.value.as < AST::Block* > () = yystack_[1].value.as < AST::Block* > ();
+	}
+#line 834 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 9: // return: RETURN conditional_expression SEMICOLON
+#line 146 "/root/repo/parser.ypp"
+                                                  {
+		yylhs.value.as < AST::ASTNode* > () = new AST::Return(*yystack_[1].value.as < AST::ASTNode* > ());
+	}
+#line 842 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 10: // statement: assignment
+#line 152 "/root/repo/parser.ypp"
+                     { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::Block* > (); }
+#line 848 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 11: // statement: if_statement
+#line 153 "/root/repo/parser.ypp"
+                       { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 854 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 12: // statement: loop_statement
+#line 154 "/root/repo/parser.ypp"
+                         { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 860 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 13: // statement: function_call SEMICOLON
+#line 155 "/root/repo/parser.ypp"
+                                  { yylhs.value.as < AST::ASTNode* > () = yystack_[1].value.as < AST::ASTNode* > (); }
+#line 866 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 14: // assignment: list_assignemtns SEMICOLON
+#line 160 "/root/repo/parser.ypp"
+                                     { yylhs.value.as < AST::Block* > () = yystack_[1].value.as < AST::Block* > (); }
+#line 872 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 15: // assignment: declaration_specifics list_assignemtns SEMICOLON
+#line 161 "/root/repo/parser.ypp"
+                                                           { 
+		yylhs.value.as < AST::Block* > () = yystack_[1].value.as < AST::Block* > ();
+		yylhs.value.as < AST::Block* > ()->distribute(yystack_[2].value.as < AST::AssignMod* > ());
+	}
+#line 881 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 16: // assignment: declaration_specifics IDENTIFIER ASSIGN function_declaration
+#line 165 "/root/repo/parser.ypp"
+                                                                       { 
+		yylhs.value.as < AST::Block* > () = new AST::Block();
+		AST::ASTNode* node = new AST::Assign(*yystack_[3].value.as < AST::AssignMod* > (), yystack_[2].value.as < Symbol > (), *yystack_[0].value.as < AST::ASTNode* > ());
+		yylhs.value.as < AST::Block* > ()->append(node);
+	 }
+#line 891 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 17: // declaration_specifics: VAR
+#line 173 "/root/repo/parser.ypp"
+              { yylhs.value.as < AST::AssignMod* > () = new AST::AssignMod("var"); }
+#line 897 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 18: // declaration_specifics: CONST
+#line 174 "/root/repo/parser.ypp"
+                { yylhs.value.as < AST::AssignMod* > () = new AST::AssignMod("const"); }
+#line 903 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 19: // list_assignemtns: list_assignemtns COMMA assignment_part
+#line 178 "/root/repo/parser.ypp"
+                                                 { yystack_[2].value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ()); yylhs.value.as < AST::Block* > () = yystack_[2].value.as < AST::Block* > (); }
+#line 909 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 20: // list_assignemtns: assignment_part
+#line 179 "/root/repo/parser.ypp"
+                          { yylhs.value.as < AST::Block* > () = new AST::Block(); yylhs.value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 915 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 21: // assignment_part: IDENTIFIER ASSIGN assignment_value
+#line 183 "/root/repo/parser.ypp"
+                                             {
+		AST::ASTNode* rhs = yystack_[0].value.as < AST::ASTNode* > ();
+		AST::AssignMod* mod = new AST::AssignMod("assign");
+		yylhs.value.as < AST::ASTNode* > () = new AST::Assign(*mod, yystack_[2].value.as < Symbol > (), *rhs);
+	 }
+#line 925 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 22: // assignment_part: IDENTIFIER ASSIGN conditional_expression
+#line 188 "/root/repo/parser.ypp"
+                                                   {
+		AST::ASTNode* rhs = yystack_[0].value.as < AST::ASTNode* > ();
+		AST::AssignMod* mod = new AST::AssignMod("assign");
+		yylhs.value.as < AST::ASTNode* > () = new AST::Assign(*mod, yystack_[2].value.as < Symbol > (), *rhs);
+	 }
+#line 935 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 23: // assignment_part: IDENTIFIER
+#line 193 "/root/repo/parser.ypp"
+                     {
+		AST::ASTNode* rhs = new AST::NullConst();
+		AST::AssignMod* mod = new AST::AssignMod("assign");
+		yylhs.value.as < AST::ASTNode* > () = new AST::Assign(*mod, yystack_[0].value.as < Symbol > (), *rhs);
+	}
+#line 945 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 24: // assignment_part: IDENTIFIER LBRACKET conditional_expression RBRACKET ASSIGN conditional_expression
+#line 198 "/root/repo/parser.ypp"
+                                                                                            {
+		AST::AssignMod* mod = new AST::AssignMod("assign");
+		yylhs.value.as < AST::ASTNode* > () = new AST::Assign(*mod, yystack_[5].value.as < Symbol > (), *yystack_[3].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 954 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 25: // assignment_part: IDENTIFIER DOT_OP IDENTIFIER ASSIGN conditional_expression
+#line 202 "/root/repo/parser.ypp"
+                                                                     {
+		AST::AssignMod* mod = new AST::AssignMod("assign");
+		yylhs.value.as < AST::ASTNode* > () = new AST::Assign(*mod, yystack_[4].value.as < Symbol > (), yystack_[2].value.as < Symbol > (), *yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 963 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 26: // assignment_part: IDENTIFIER DOT_OP NUMBER ASSIGN conditional_expression
+#line 206 "/root/repo/parser.ypp"
+                                                                 {
+		AST::AssignMod* mod = new AST::AssignMod("assign");
+		yylhs.value.as < AST::ASTNode* > () = new AST::Assign(*mod, yystack_[4].value.as < Symbol > (), intern(yystack_[2].value.as < string > ()), *yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 972 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 27: // assignment_value: LBRACKET function_call_params RBRACKET
+#line 213 "/root/repo/parser.ypp"
+                                                 {
+		AST::ArrayDecl* decl = new AST::ArrayDecl();
+		decl->flat(yystack_[1].value.as < AST::Block* > ());
+		yylhs.value.as < AST::ASTNode* > () = decl;
+	}
+#line 982 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 28: // tuple_element: IDENTIFIER DOT_OP IDENTIFIER
+#line 221 "/root/repo/parser.ypp"
+                                       {
+		AST::StringConst* ident = new AST::StringConst(::symbol_name(yystack_[2].value.as < Symbol > ())); 
+		AST::StringConst* idx = new AST::StringConst(::symbol_name(yystack_[0].value.as < Symbol > ()));
+		yylhs.value.as < AST::ASTNode* > () = new AST::TupleEl(*ident, *idx);
+	}
+#line 992 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 29: // tuple_element: IDENTIFIER DOT_OP NUMBER
+#line 226 "/root/repo/parser.ypp"
+                                   {
+		AST::StringConst* ident = new AST::StringConst(::symbol_name(yystack_[2].value.as < Symbol > ())); 
+		AST::NumberConst* idx = new AST::NumberConst(yystack_[0].value.as < string > ());
+		yylhs.value.as < AST::ASTNode* > () = new AST::TupleEl(*ident, *idx);
+	}
+#line 1002 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 30: // assignment_type: NULL_TYPE
+#line 234 "/root/repo/parser.ypp"
+                    { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("null"); }
+#line 1008 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 31: // assignment_type: BOOL_TYPE
+#line 235 "/root/repo/parser.ypp"
+                    { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("bool"); }
+#line 1014 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 32: // assignment_type: NUMBER_TYPE
+#line 236 "/root/repo/parser.ypp"
+                      { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("number"); }
+#line 1020 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 33: // assignment_type: STRING_TYPE
+#line 237 "/root/repo/parser.ypp"
+                      { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("string"); }
+#line 1026 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 34: // expression: term
+#line 241 "/root/repo/parser.ypp"
+               { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 1032 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 35: // expression: expression PLUS term
+#line 242 "/root/repo/parser.ypp"
+                               { yylhs.value.as < AST::ASTNode* > () = new AST::Plus(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1038 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 36: // expression: expression MINUS term
+#line 243 "/root/repo/parser.ypp"
+                                { yylhs.value.as < AST::ASTNode* > () = new AST::Minus(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1044 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 37: // expression: expression IS assignment_type
+#line 244 "/root/repo/parser.ypp"
+                                        {
+		yylhs.value.as < AST::ASTNode* > () = new AST::IsOp(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 1052 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 38: // term: factor
+#line 250 "/root/repo/parser.ypp"
+                 { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 1058 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 39: // term: term MUL factor
+#line 251 "/root/repo/parser.ypp"
+                          { yylhs.value.as < AST::ASTNode* > () = new AST::Times(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1064 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 40: // term: term DIV factor
+#line 252 "/root/repo/parser.ypp"
+                          { yylhs.value.as < AST::ASTNode* > () = new AST::Div(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1070 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 41: // factor: NUMBER
+#line 256 "/root/repo/parser.ypp"
+                 { yylhs.value.as < AST::ASTNode* > () = new AST::NumberConst(yystack_[0].value.as < string > ()); }
+#line 1076 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 42: // factor: STRING
+#line 257 "/root/repo/parser.ypp"
+                 { yylhs.value.as < AST::ASTNode* > () = new AST::StringConst(yystack_[0].value.as < string > ()); }
+#line 1082 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 43: // factor: BOOL
+#line 258 "/root/repo/parser.ypp"
+               { yylhs.value.as < AST::ASTNode* > () = new AST::BoolConst(yystack_[0].value.as < string > ()); }
+#line 1088 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 44: // factor: IDENTIFIER
+#line 259 "/root/repo/parser.ypp"
+                     { yylhs.value.as < AST::ASTNode* > () = new AST::Ident(yystack_[0].value.as < Symbol > ()); }
+#line 1094 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 45: // factor: function_call
+#line 260 "/root/repo/parser.ypp"
+                        { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 1100 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 46: // factor: tuple_element
+#line 261 "/root/repo/parser.ypp"
+                        { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 1106 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 47: // factor: LBRACE list_assignemtns RBRACE
+#line 262 "/root/repo/parser.ypp"
+                                         {
+		AST::TupleDecl* decl = new AST::TupleDecl();
+		decl->flat(yystack_[1].value.as < AST::Block* > ());
+		yylhs.value.as < AST::ASTNode* > () = decl;
+	 }
+#line 1116 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 48: // factor: INTERP_BEGIN interpolation INTERP_END
+#line 267 "/root/repo/parser.ypp"
+                                                { yylhs.value.as < AST::ASTNode* > () = yystack_[1].value.as < AST::Interpolation* > (); }
+#line 1122 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 49: // factor: LBRACE dict_entries RBRACE
+#line 268 "/root/repo/parser.ypp"
+                                     { yylhs.value.as < AST::ASTNode* > () = yystack_[1].value.as < AST::DictDecl* > (); }
+#line 1128 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 50: // factor: LBRACE RBRACE
+#line 269 "/root/repo/parser.ypp"
+                        { yylhs.value.as < AST::ASTNode* > () = new AST::DictDecl(); }
+#line 1134 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 51: // factor: IDENTIFIER LBRACKET conditional_expression RBRACKET
+#line 270 "/root/repo/parser.ypp"
+                                                              { 
+		AST::Ident* ident = new AST::Ident(yystack_[3].value.as < Symbol > ()); 
+		yylhs.value.as < AST::ASTNode* > () = new AST::ArrayEl(*ident, *yystack_[1].value.as < AST::ASTNode* > ());
+	 }
+#line 1143 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 52: // factor: LPAREN conditional_expression RPAREN
+#line 274 "/root/repo/parser.ypp"
+                                               { yylhs.value.as < AST::ASTNode* > () = yystack_[1].value.as < AST::ASTNode* > (); }
+#line 1149 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 53: // dict_entries: conditional_expression COLON conditional_expression
+#line 279 "/root/repo/parser.ypp"
+                                                              {
+		yylhs.value.as < AST::DictDecl* > () = new AST::DictDecl();
+		yylhs.value.as < AST::DictDecl* > ()->append(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 1158 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 54: // dict_entries: dict_entries COMMA conditional_expression COLON conditional_expression
+#line 283 "/root/repo/parser.ypp"
+                                                                                 {
+		yystack_[4].value.as < AST::DictDecl* > ()->append(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ());
+		yylhs.value.as < AST::DictDecl* > () = yystack_[4].value.as < AST::DictDecl* > ();
+	}
+#line 1167 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 55: // interpolation: %empty
+#line 290 "/root/repo/parser.ypp"
+                 { yylhs.value.as < AST::Interpolation* > () = new AST::Interpolation(); }
+#line 1173 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 56: // interpolation: interpolation STRING
+#line 291 "/root/repo/parser.ypp"
+                               { yystack_[1].value.as < AST::Interpolation* > ()->append_text(yystack_[0].value.as < string > ()); yylhs.value.as < AST::Interpolation* > () = yystack_[1].value.as < AST::Interpolation* > (); }
+#line 1179 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 57: // interpolation: interpolation LBRACE conditional_expression RBRACE
+#line 292 "/root/repo/parser.ypp"
+                                                             {
+		yystack_[3].value.as < AST::Interpolation* > ()->append_expr(*yystack_[1].value.as < AST::ASTNode* > ());
+		yylhs.value.as < AST::Interpolation* > () = yystack_[3].value.as < AST::Interpolation* > ();
+	}
+#line 1188 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 58: // operation: PRINT conditional_expression SEMICOLON
+#line 299 "/root/repo/parser.ypp"
+                                                 { yylhs.value.as < AST::ASTNode* > () = new AST::Print(*yystack_[1].value.as < AST::ASTNode* > ()); }
+#line 1194 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 59: // operation: read_keyword IDENTIFIER SEMICOLON
+#line 300 "/root/repo/parser.ypp"
+                                            { 
+		yylhs.value.as < AST::ASTNode* > () = new AST::Read(*yystack_[2].value.as < AST::ASTNode* > (), yystack_[1].value.as < Symbol > ()); 
+	 }
+#line 1202 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 60: // operation: comp_expression SEMICOLON
+#line 303 "/root/repo/parser.ypp"
+                                    { yylhs.value.as < AST::ASTNode* > () = yystack_[1].value.as < AST::ASTNode* > (); }
+#line 1208 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 61: // comp_expression: IDENTIFIER operation_op ASSIGN conditional_expression
+#line 307 "/root/repo/parser.ypp"
+                                                                {
+		AST::Ident* ident = new AST::Ident(yystack_[3].value.as < Symbol > ()); 
+		yylhs.value.as < AST::ASTNode* > () = new AST::CompExp(*ident, *yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); 
+	 }
+#line 1217 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 62: // comp_expression: tuple_element operation_op ASSIGN conditional_expression
+#line 311 "/root/repo/parser.ypp"
+                                                                   {
+		yylhs.value.as < AST::ASTNode* > () = new AST::CompExp(*yystack_[3].value.as < AST::ASTNode* > (), *yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); 	
+	}
+#line 1225 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 63: // operation_op: PLUS
+#line 317 "/root/repo/parser.ypp"
+               { yylhs.value.as < AST::ASTNode* > () = new AST::OpType("Plus"); }
+#line 1231 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 64: // operation_op: MINUS
+#line 318 "/root/repo/parser.ypp"
+                { yylhs.value.as < AST::ASTNode* > () = new AST::OpType("Minus"); }
+#line 1237 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 65: // operation_op: MUL
+#line 319 "/root/repo/parser.ypp"
+              { yylhs.value.as < AST::ASTNode* > () = new AST::OpType("Mul"); }
+#line 1243 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 66: // operation_op: DIV
+#line 320 "/root/repo/parser.ypp"
+              { yylhs.value.as < AST::ASTNode* > () = new AST::OpType("Div"); }
+#line 1249 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 67: // read_keyword: READ_INT
+#line 324 "/root/repo/parser.ypp"
+                   { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("number"); }
+#line 1255 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 68: // read_keyword: READ_REAL
+#line 325 "/root/repo/parser.ypp"
+                    { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("number"); }
+#line 1261 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 69: // read_keyword: READ_STRING
+#line 326 "/root/repo/parser.ypp"
+                      { yylhs.value.as < AST::ASTNode* > () = new AST::VarType("string"); }
+#line 1267 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 70: // if_statement: IF conditional_expression THEN block if_alternatives END
+#line 329 "/root/repo/parser.ypp"
+                                                                   {
+		yylhs.value.as < AST::ASTNode* > () = new AST::If(*yystack_[4].value.as < AST::ASTNode* > (), *yystack_[2].value.as < AST::Block* > (), *yystack_[1].value.as < AST::Block* > ());
+	}
+#line 1275 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 71: // conditional_expression: conditional_expression AND conditional_expression
+#line 335 "/root/repo/parser.ypp"
+                                                            { yylhs.value.as < AST::ASTNode* > () = new AST::And(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1281 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 72: // conditional_expression: conditional_expression OR conditional_expression
+#line 336 "/root/repo/parser.ypp"
+                                                           { yylhs.value.as < AST::ASTNode* > () = new AST::Or(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1287 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 73: // conditional_expression: NOT conditional_expression
+#line 337 "/root/repo/parser.ypp"
+                                     { yylhs.value.as < AST::ASTNode* > () = new AST::Not(*yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1293 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 74: // conditional_expression: expression LESS expression
+#line 338 "/root/repo/parser.ypp"
+                                     { yylhs.value.as < AST::ASTNode* > () = new AST::Less(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1299 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 75: // conditional_expression: expression LESS_E expression
+#line 339 "/root/repo/parser.ypp"
+                                       { yylhs.value.as < AST::ASTNode* > () = new AST::Less_E(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1305 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 76: // conditional_expression: expression GREATER expression
+#line 340 "/root/repo/parser.ypp"
+                                        { yylhs.value.as < AST::ASTNode* > () = new AST::Greater(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1311 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 77: // conditional_expression: expression GREATER_E expression
+#line 341 "/root/repo/parser.ypp"
+                                          { yylhs.value.as < AST::ASTNode* > () = new AST::Greater_E(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1317 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 78: // conditional_expression: expression EQUAL expression
+#line 342 "/root/repo/parser.ypp"
+                                      { yylhs.value.as < AST::ASTNode* > () = new AST::Equals(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1323 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 79: // conditional_expression: expression NOT_EQUAL expression
+#line 343 "/root/repo/parser.ypp"
+                                          { yylhs.value.as < AST::ASTNode* > () = new AST::Not_Equals(*yystack_[2].value.as < AST::ASTNode* > (), *yystack_[0].value.as < AST::ASTNode* > ()); }
+#line 1329 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 80: // conditional_expression: expression
+#line 344 "/root/repo/parser.ypp"
+                     { yylhs.value.as < AST::ASTNode* > () = yystack_[0].value.as < AST::ASTNode* > (); }
+#line 1335 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 81: // if_alternatives: %empty
+#line 348 "/root/repo/parser.ypp"
+                 { yylhs.value.as < AST::Block* > () = new AST::Block(); }
+#line 1341 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 82: // if_alternatives: ELSE block
+#line 349 "/root/repo/parser.ypp"
+                     { yylhs.value.as < AST::Block* > () = yystack_[0].value.as < AST::Block* > (); }
+#line 1347 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 83: // loop_statement: WHILE_L conditional_expression LOOP block END
+#line 353 "/root/repo/parser.ypp"
+                                                        { yylhs.value.as < AST::ASTNode* > () = new AST::While(*yystack_[3].value.as < AST::ASTNode* > (), *yystack_[1].value.as < AST::Block* > ()); }
+#line 1353 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 84: // loop_statement: FOR_L assignment conditional_expression SEMICOLON comp_expression LOOP block END
+#line 354 "/root/repo/parser.ypp"
+                                                                                           {
+		AST::For* loop = new AST::For(*yystack_[5].value.as < AST::ASTNode* > (), *yystack_[3].value.as < AST::ASTNode* > (), *yystack_[1].value.as < AST::Block* > ());
+		loop->flat(yystack_[6].value.as < AST::Block* > ());
+		yylhs.value.as < AST::ASTNode* > () = loop;
+	}
+#line 1363 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 85: // function_declaration: FUNC LPAREN function_params RPAREN DO block END
+#line 362 "/root/repo/parser.ypp"
+                                                          { 
+		AST::FuncDecl* decl = new AST::FuncDecl(*yystack_[1].value.as < AST::Block* > ());
+		decl->flat(yystack_[4].value.as < AST::Block* > ());
+		yylhs.value.as < AST::ASTNode* > () = decl;
+	 }
+#line 1373 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 86: // function_call: IDENTIFIER LPAREN function_call_params RPAREN
+#line 369 "/root/repo/parser.ypp"
+                                                        { 
+		AST::Ident* ident = new AST::Ident(yystack_[3].value.as < Symbol > ());
+		AST::FuncCall* call = new AST::FuncCall(*ident);
+		call->flat(yystack_[1].value.as < AST::Block* > ());
+		if (!call_lines.empty()) {
+			call->set_line(call_lines.back());
+			call_lines.pop_back();
+		}
+		yylhs.value.as < AST::ASTNode* > () = call;
+	 }
+#line 1388 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 87: // function_params: function_params COMMA IDENTIFIER
+#line 381 "/root/repo/parser.ypp"
+                                           {
+		AST::StringConst* name = new AST::StringConst(::symbol_name(yystack_[0].value.as < Symbol > ()));
+		yystack_[2].value.as < AST::Block* > ()->append(name);
+		yylhs.value.as < AST::Block* > () = yystack_[2].value.as < AST::Block* > ();
+	}
+#line 1398 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 88: // function_params: IDENTIFIER
+#line 386 "/root/repo/parser.ypp"
+                     {
+		yylhs.value.as < AST::Block* > () = new AST::Block();
+		AST::StringConst* name = new AST::StringConst(::symbol_name(yystack_[0].value.as < Symbol > ()));
+		yylhs.value.as < AST::Block* > ()->append(name);
+	}
+#line 1408 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 89: // function_params: %empty
+#line 391 "/root/repo/parser.ypp"
+                 {
+		yylhs.value.as < AST::Block* > () = new AST::Block();
+	}
+#line 1416 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 90: // function_call_params: function_call_params COMMA conditional_expression
+#line 397 "/root/repo/parser.ypp"
+                                                            {
+		yystack_[2].value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ());
+		yylhs.value.as < AST::Block* > () = yystack_[2].value.as < AST::Block* > ();
+	}
+#line 1425 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 91: // function_call_params: conditional_expression
+#line 401 "/root/repo/parser.ypp"
+                                 {
+		yylhs.value.as < AST::Block* > () = new AST::Block();
+		yylhs.value.as < AST::Block* > ()->append(yystack_[0].value.as < AST::ASTNode* > ());
+	}
+#line 1434 "/root/repo/parser.tab.cpp"
+    break;
+
+  case 92: // function_call_params: %empty
+#line 405 "/root/repo/parser.ypp"
+                 {
+		yylhs.value.as < AST::Block* > () = new AST::Block();
+	}
+#line 1442 "/root/repo/parser.tab.cpp"
+    break;
+
+
+#line 1446 "/root/repo/parser.tab.cpp"
+
+            default:
+              break;
+            }
+        }
+#if YY_EXCEPTIONS
+      catch (const syntax_error& yyexc)
+        {
+          YYCDEBUG << "Caught exception: " << yyexc.what() << '\n';
+          error (yyexc);
+          YYERROR;
+        }
+#endif // YY_EXCEPTIONS
+      YY_SYMBOL_PRINT ("-> $$ =", yylhs);
+      yypop_ (yylen);
+      yylen = 0;
+
+      // Shift the result of the reduction.
+      yypush_ (YY_NULLPTR, YY_MOVE (yylhs));
+    }
+    goto yynewstate;
+
+
+  /*--------------------------------------.
+  | yyerrlab -- here on detecting error.  |
+  `--------------------------------------*/
+  yyerrlab:
+    // If not already recovering from an error, report this error.
+    if (!yyerrstatus_)
+      {
+        ++yynerrs_;
+        context yyctx (*this, yyla);
+        std::string msg = yysyntax_error_ (yyctx);
+        error (YY_MOVE (msg));
+      }
+
+
+    if (yyerrstatus_ == 3)
+      {
+        /* If just tried and failed to reuse lookahead token after an
+           error, discard it.  */
+
+        // Return failure if at end of input.
+        if (yyla.kind () == symbol_kind::S_YYEOF)
+          YYABORT;
+        else if (!yyla.empty ())
+          {
+            yy_destroy_ ("Error: discarding", yyla);
+            yyla.clear ();
+          }
+      }
+
+    // Else will try to reuse lookahead token after shifting the error token.
+    goto yyerrlab1;
+
+
+  /*---------------------------------------------------.
+  | yyerrorlab -- error raised explicitly by YYERROR.  |
+  `---------------------------------------------------*/
+  yyerrorlab:
+    /* Pacify compilers when the user code never invokes YYERROR and
+       the label yyerrorlab therefore never appears in user code.  */
+    if (false)
+      YYERROR;
+
+    /* Do not reclaim the symbols of the rule whose action triggered
+       this YYERROR.  */
+    yypop_ (yylen);
+    yylen = 0;
+    YY_STACK_PRINT ();
+    goto yyerrlab1;
+
+
+  /*-------------------------------------------------------------.
+  | yyerrlab1 -- common code for both syntax error and YYERROR.  |
+  `-------------------------------------------------------------*/
+  yyerrlab1:
+    yyerrstatus_ = 3;   // Each real token shifted decrements this.
+    // Pop stack until we find a state that shifts the error token.
+    for (;;)
+      {
+        yyn = yypact_[+yystack_[0].state];
+        if (!yy_pact_value_is_default_ (yyn))
+          {
+            yyn += symbol_kind::S_YYerror;
+            if (0 <= yyn && yyn <= yylast_
+                && yycheck_[yyn] == symbol_kind::S_YYerror)
+              {
+                yyn = yytable_[yyn];
+                if (0 < yyn)
+                  break;
+              }
+          }
+
+        // Pop the current state because it cannot handle the error token.
+        if (yystack_.size () == 1)
+          YYABORT;
+
+        yy_destroy_ ("Error: popping", yystack_[0]);
+        yypop_ ();
+        YY_STACK_PRINT ();
+      }
+    {
+      stack_symbol_type error_token;
+
+
+      // Shift the error token.
+      error_token.state = state_type (yyn);
+      yypush_ ("Shifting", YY_MOVE (error_token));
+    }
+    goto yynewstate;
+
+
+  /*-------------------------------------.
+  | yyacceptlab -- YYACCEPT comes here.  |
+  `-------------------------------------*/
+  yyacceptlab:
+    yyresult = 0;
+    goto yyreturn;
+
+
+  /*-----------------------------------.
+  | yyabortlab -- YYABORT comes here.  |
+  `-----------------------------------*/
+  yyabortlab:
+    yyresult = 1;
+    goto yyreturn;
+
+
+  /*-----------------------------------------------------.
+  | yyreturn -- parsing is finished, return the result.  |
+  `-----------------------------------------------------*/
+  yyreturn:
+    if (!yyla.empty ())
+      yy_destroy_ ("Cleanup: discarding lookahead", yyla);
+
+    /* Do not reclaim the symbols of the rule whose action triggered
+       this YYABORT or YYACCEPT.  */
+    yypop_ (yylen);
+    YY_STACK_PRINT ();
+    while (1 < yystack_.size ())
+      {
+        yy_destroy_ ("Cleanup: popping", yystack_[0]);
+        yypop_ ();
+      }
+
+    return yyresult;
+  }
+#if YY_EXCEPTIONS
+    catch (...)
+      {
+        YYCDEBUG << "Exception caught: cleaning lookahead and stack\n";
+        // Do not try to display the values of the reclaimed symbols,
+        // as their printers might throw an exception.
+        if (!yyla.empty ())
+          yy_destroy_ (YY_NULLPTR, yyla);
+
+        while (1 < yystack_.size ())
+          {
+            yy_destroy_ (YY_NULLPTR, yystack_[0]);
+            yypop_ ();
+          }
+        throw;
+      }
+#endif // YY_EXCEPTIONS
+  }
+
+  void
+  parser::error (const syntax_error& yyexc)
+  {
+    error (yyexc.what ());
+  }
+
+  /* Return YYSTR after stripping away unnecessary quotes and
+     backslashes, so that it's suitable for yyerror.  The heuristic is
+     that double-quoting is unnecessary unless the string contains an
+     apostrophe, a comma, or backslash (other than backslash-backslash).
+     YYSTR is taken from yytname.  */
+  std::string
+  parser::yytnamerr_ (const char *yystr)
+  {
+    if (*yystr == '"')
+      {
+        std::string yyr;
+        char const *yyp = yystr;
+
+        for (;;)
+          switch (*++yyp)
+            {
+            case '\'':
+            case ',':
+              goto do_not_strip_quotes;
+
+            case '\\':
+              if (*++yyp != '\\')
+                goto do_not_strip_quotes;
+              else
+                goto append;
+
+            append:
+            default:
+              yyr += *yyp;
+              break;
+
+            case '"':
+              return yyr;
+            }
+      do_not_strip_quotes: ;
+      }
+
+    return yystr;
+  }
+
+  std::string
+  parser::symbol_name (symbol_kind_type yysymbol)
+  {
+    return yytnamerr_ (yytname_[yysymbol]);
+  }
+
+
+
+  // parser::context.
+  parser::context::context (const parser& yyparser, const symbol_type& yyla)
+    : yyparser_ (yyparser)
+    , yyla_ (yyla)
+  {}
+
+  int
+  parser::context::expected_tokens (symbol_kind_type yyarg[], int yyargn) const
+  {
+    // Actual number of expected tokens
+    int yycount = 0;
+
+    const int yyn = yypact_[+yyparser_.yystack_[0].state];
+    if (!yy_pact_value_is_default_ (yyn))
+      {
+        /* Start YYX at -YYN if negative to avoid negative indexes in
+           YYCHECK.  In other words, skip the first -YYN actions for
+           this state because they are default actions.  */
+        const int yyxbegin = yyn < 0 ? -yyn : 0;
+        // Stay within bounds of both yycheck and yytname.
+        const int yychecklim = yylast_ - yyn + 1;
+        const int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+        for (int yyx = yyxbegin; yyx < yyxend; ++yyx)
+          if (yycheck_[yyx + yyn] == yyx && yyx != symbol_kind::S_YYerror
+              && !yy_table_value_is_error_ (yytable_[yyx + yyn]))
+            {
+              if (!yyarg)
+                ++yycount;
+              else if (yycount == yyargn)
+                return 0;
+              else
+                yyarg[yycount++] = YY_CAST (symbol_kind_type, yyx);
+            }
+      }
+
+    if (yyarg && yycount == 0 && 0 < yyargn)
+      yyarg[0] = symbol_kind::S_YYEMPTY;
+    return yycount;
+  }
+
+
+
+
+
+
+  int
+  parser::yy_syntax_error_arguments_ (const context& yyctx,
+                                                 symbol_kind_type yyarg[], int yyargn) const
+  {
+    /* There are many possibilities here to consider:
+       - If this state is a consistent state with a default action, then
+         the only way this function was invoked is if the default action
+         is an error action.  In that case, don't check for expected
+         tokens because there are none.
+       - The only way there can be no lookahead present (in yyla) is
+         if this state is a consistent state with a default action.
+         Thus, detecting the absence of a lookahead is sufficient to
+         determine that there is no unexpected or expected token to
+         report.  In that case, just report a simple "syntax error".
+       - Don't assume there isn't a lookahead just because this state is
+         a consistent state with a default action.  There might have
+         been a previous inconsistent state, consistent state with a
+         non-default action, or user semantic action that manipulated
+         yyla.  (However, yyla is currently not documented for users.)
+       - Of course, the expected token list depends on states to have
+         correct lookahead information, and it depends on the parser not
+         to perform extra reductions after fetching a lookahead from the
+         scanner and before detecting a syntax error.  Thus, state merging
+         (from LALR or IELR) and default reductions corrupt the expected
+         token list.  However, the list is correct for canonical LR with
+         one exception: it will still contain any token that will not be
+         accepted due to an error action in a later state.
+    */
+
+    if (!yyctx.lookahead ().empty ())
+      {
+        if (yyarg)
+          yyarg[0] = yyctx.token ();
+        int yyn = yyctx.expected_tokens (yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+        return yyn + 1;
+      }
+    return 0;
+  }
+
+  // Generate an error message.
+  std::string
+  parser::yysyntax_error_ (const context& yyctx) const
+  {
+    // Its maximum.
+    enum { YYARGS_MAX = 5 };
+    // Arguments of yyformat.
+    symbol_kind_type yyarg[YYARGS_MAX];
+    int yycount = yy_syntax_error_arguments_ (yyctx, yyarg, YYARGS_MAX);
+
+    char const* yyformat = YY_NULLPTR;
+    switch (yycount)
+      {
+#define YYCASE_(N, S)                         \
+        case N:                               \
+          yyformat = S;                       \
+        break
+      default: // Avoid compiler warnings.
+        YYCASE_ (0, YY_("syntax error"));
+        YYCASE_ (1, YY_("syntax error, unexpected %s"));
+        YYCASE_ (2, YY_("syntax error, unexpected %s, expecting %s"));
+        YYCASE_ (3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+        YYCASE_ (4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+        YYCASE_ (5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+      }
+
+    std::string yyres;
+    // Argument number.
+    std::ptrdiff_t yyi = 0;
+    for (char const* yyp = yyformat; *yyp; ++yyp)
+      if (yyp[0] == '%' && yyp[1] == 's' && yyi < yycount)
+        {
+          yyres += symbol_name (yyarg[yyi++]);
+          ++yyp;
+        }
+      else
+        yyres += *yyp;
+    return yyres;
+  }
+
+
+  const signed char parser::yypact_ninf_ = -98;
+
+  const signed char parser::yytable_ninf_ = -24;
+
+  const short
+  parser::yypact_[] =
+  {
+     321,   324,   -98,   -98,   -98,   -98,   -98,    65,    65,    65,
+     218,    65,     6,   321,   -98,   -98,   -98,    28,   114,   -98,
+     227,   -98,    20,    52,   -98,   -98,    42,    11,   -98,   -98,
+     -98,   -98,    65,    65,    21,    48,    97,   -98,   -98,   -98,
+      65,    35,    65,   -98,   -98,   348,   175,   -98,    -3,   -98,
+      90,   138,    26,    65,     3,   -98,   -98,   -98,   -98,    61,
+     197,    72,   -98,    83,   -98,    88,   -98,    65,   -98,   168,
+     168,    15,    54,    94,   105,    65,    65,   224,    22,   194,
+     -98,    19,    71,   117,   -98,    -4,   249,    77,    77,    77,
+      77,    77,    77,    77,    77,    77,    77,   -98,    65,    65,
+     321,   321,   250,    12,   -98,     5,   -98,   -98,    65,   -98,
+     118,    65,   -98,   109,    65,    65,   168,    93,   -98,   -98,
+     -98,    65,   -98,    65,   -98,    65,   -98,    65,   -98,   -98,
+     -98,   -98,   -98,   -98,   175,   175,   143,   143,   143,   143,
+     143,   143,   -98,   -98,   -98,   -98,    84,   206,    94,   105,
+     130,     1,   -98,   168,   -98,   168,    65,   168,   168,   -98,
+      98,   188,   168,   108,   321,   103,   -98,    76,   107,   152,
+     168,   109,    65,   -98,   321,   -98,   321,   -98,    44,   168,
+     248,   159,   126,   -98,   -98,   321,   292,   -98
+  };
+
+  const signed char
+  parser::yydefact_[] =
+  {
+       0,    23,    17,    18,    67,    68,    69,     0,     0,     0,
+       0,     0,     0,     2,     7,     3,    10,     0,     0,    20,
+       0,     4,     0,     0,    11,    12,     0,     0,    63,    64,
+      65,    66,    92,     0,     0,     0,    44,    41,    42,    43,
+       0,     0,     0,    55,    46,    80,    34,    38,     0,    45,
+       0,     0,    23,     0,     0,     1,     8,     5,     6,    23,
+       0,     0,    14,     0,    60,     0,    13,    92,    21,    22,
+      91,     0,     0,    28,    29,     0,     0,     0,     0,    44,
+      50,     0,     0,     0,    73,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,    58,     0,     0,
+       0,     0,     0,     0,     9,     0,    15,    19,     0,    59,
+       0,     0,    86,     0,     0,     0,    61,     0,    28,    29,
+      52,     0,    47,     0,    49,     0,    56,     0,    48,    32,
+      33,    31,    30,    37,    35,    36,    74,    75,    76,    77,
+      78,    79,    39,    40,    71,    72,    81,     0,     0,     0,
+       0,     0,    16,    62,    27,    90,     0,    25,    26,    51,
+       0,     0,    53,     0,     0,     0,    83,     0,     0,    89,
+      24,    51,     0,    57,    82,    70,     0,    88,     0,    54,
+       0,     0,     0,    84,    87,     0,     0,    85
+  };
+
+  const short
+  parser::yypgoto_[] =
+  {
+     -98,   -98,   -97,   -11,    -8,   155,   -98,     2,   116,   -98,
+       0,   -98,   113,   176,   172,   -98,   -98,    10,    29,   171,
+     -98,   -98,   190,   -98,   -98,   -98,     7,   -98,   133
+  };
+
+  const unsigned char
+  parser::yydefgoto_[] =
+  {
+       0,    12,    13,    14,    15,    16,    17,    18,    19,    68,
+      44,   133,    45,    46,    47,    82,    85,    21,    22,    35,
+      23,    24,    69,   165,    25,   152,    49,   178,    71
+  };
+
+  const short
+  parser::yytable_[] =
+  {
+      20,   126,    56,   146,   147,    57,    55,    26,    36,    37,
+      38,    39,    97,    20,    36,    37,    38,    39,   104,    60,
+      26,   127,   169,    58,    73,    74,    40,   150,    67,   111,
+      41,    59,    40,    61,    67,    64,    41,   112,    79,    37,
+      38,    39,    27,    81,   120,   122,    42,    98,    99,    33,
+     151,   128,    42,    98,    99,    65,    40,    66,   181,    43,
+      41,    80,    98,    99,    75,    43,   182,   174,    36,    37,
+      38,    39,    98,    99,   102,    52,    42,   105,   113,   180,
+      36,    37,    38,    39,    33,   123,    40,     1,   186,    43,
+      41,     2,     3,    28,    29,    30,    31,   124,    40,   108,
+      20,    20,    41,   109,    98,    99,    42,    26,    26,   102,
+     114,     4,     5,     6,     7,     8,   164,   159,    32,    43,
+      76,   115,   171,   100,    77,   156,     9,    10,    61,    62,
+      11,    43,   111,   167,   173,    56,    56,   175,    57,    57,
+      98,    99,   154,    98,    99,    77,    20,    20,    98,    99,
+      20,   176,    86,    26,    26,   177,    58,    58,    98,    99,
+      87,    88,   184,    56,    20,    53,    57,    98,    99,    56,
+     125,    26,    57,   185,    20,    56,    20,   107,    57,   168,
+      20,    26,   101,    26,    58,    20,    20,    26,    98,    99,
+      58,    63,    26,    26,    95,    96,    58,    48,    50,    51,
+     110,    54,   136,   137,   138,   139,   140,   141,   -23,     1,
+      27,    61,   106,     2,     3,    32,     0,   121,    98,    99,
+     -23,    52,    70,    72,     0,     2,     3,   118,   119,     0,
+      78,    83,    84,     4,     5,     6,     7,     8,    98,    99,
+     166,   172,    34,   103,    28,    29,    30,    31,     9,    10,
+       0,     1,    11,   148,   149,     2,     3,    70,     0,   129,
+     130,   131,   132,   134,   135,   116,   117,   142,   143,     0,
+       0,     0,     0,     0,     0,     4,     5,     6,     7,     8,
+       0,     0,   183,     0,     0,     0,     0,     0,   144,   145,
+       9,    10,     0,     0,    11,     1,     0,     0,   153,     2,
+       3,   155,     0,     0,   157,   158,     0,     0,     0,     0,
+       0,   160,     0,   161,     0,   162,     0,   163,     0,     4,
+       5,     6,     7,     8,     1,     0,   187,     0,     2,     3,
+       0,     0,     0,     0,     9,    10,     0,     0,    11,     0,
+      27,    28,    29,    30,    31,    32,   170,    33,     4,     5,
+       6,     7,     8,     0,     0,     0,     0,    86,     0,     0,
+       0,     0,   179,     9,    10,    87,    88,    11,     0,     0,
+       0,     0,    34,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,    89,    90,    91,    92,    93,    94
+  };
+
+  const short
+  parser::yycheck_[] =
+  {
+       0,     5,    13,   100,   101,    13,     0,     0,     3,     4,
+       5,     6,    15,    13,     3,     4,     5,     6,    15,    17,
+      13,    25,    21,    13,     3,     4,    21,    15,    23,    14,
+      25,     3,    21,    14,    23,    15,    25,    22,     3,     4,
+       5,     6,    16,    41,    22,    26,    41,    50,    51,    23,
+      45,    55,    41,    50,    51,     3,    21,    15,    14,    54,
+      25,    26,    50,    51,    16,    54,    22,   164,     3,     4,
+       5,     6,    50,    51,    48,     3,    41,    16,    24,   176,
+       3,     4,     5,     6,    23,    14,    21,     3,   185,    54,
+      25,     7,     8,    17,    18,    19,    20,    26,    21,    16,
+     100,   101,    25,    15,    50,    51,    41,   100,   101,    48,
+      16,    27,    28,    29,    30,    31,    32,    24,    21,    54,
+      23,    16,    24,    33,    48,    16,    42,    43,    14,    15,
+      46,    54,    14,     3,    26,   146,   147,    34,   146,   147,
+      50,    51,    24,    50,    51,    48,   146,   147,    50,    51,
+     150,    44,     9,   146,   147,     3,   146,   147,    50,    51,
+      17,    18,     3,   174,   164,    10,   174,    50,    51,   180,
+      53,   164,   180,    47,   174,   186,   176,    61,   186,   150,
+     180,   174,    44,   176,   174,   185,   186,   180,    50,    51,
+     180,    20,   185,   186,    19,    20,   186,     7,     8,     9,
+      67,    11,    89,    90,    91,    92,    93,    94,    14,     3,
+      16,    14,    15,     7,     8,    21,    -1,    23,    50,    51,
+      26,     3,    32,    33,    -1,     7,     8,     3,     4,    -1,
+      40,    41,    42,    27,    28,    29,    30,    31,    50,    51,
+      34,    53,    48,    53,    17,    18,    19,    20,    42,    43,
+      -1,     3,    46,     3,     4,     7,     8,    67,    -1,    10,
+      11,    12,    13,    87,    88,    75,    76,    95,    96,    -1,
+      -1,    -1,    -1,    -1,    -1,    27,    28,    29,    30,    31,
+      -1,    -1,    34,    -1,    -1,    -1,    -1,    -1,    98,    99,
+      42,    43,    -1,    -1,    46,     3,    -1,    -1,   108,     7,
+       8,   111,    -1,    -1,   114,   115,    -1,    -1,    -1,    -1,
+      -1,   121,    -1,   123,    -1,   125,    -1,   127,    -1,    27,
+      28,    29,    30,    31,     3,    -1,    34,    -1,     7,     8,
+      -1,    -1,    -1,    -1,    42,    43,    -1,    -1,    46,    -1,
+      16,    17,    18,    19,    20,    21,   156,    23,    27,    28,
+      29,    30,    31,    -1,    -1,    -1,    -1,     9,    -1,    -1,
+      -1,    -1,   172,    42,    43,    17,    18,    46,    -1,    -1,
+      -1,    -1,    48,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    35,    36,    37,    38,    39,    40
+  };
+
+  const signed char
+  parser::yystos_[] =
+  {
+       0,     3,     7,     8,    27,    28,    29,    30,    31,    42,
+      43,    46,    57,    58,    59,    60,    61,    62,    63,    64,
+      66,    73,    74,    76,    77,    80,    82,    16,    17,    18,
+      19,    20,    21,    23,    48,    75,     3,     4,     5,     6,
+      21,    25,    41,    54,    66,    68,    69,    70,    78,    82,
+      78,    78,     3,    61,    78,     0,    59,    60,    73,     3,
+      63,    14,    15,    75,    15,     3,    15,    23,    65,    78,
+      78,    84,    78,     3,     4,    16,    23,    48,    78,     3,
+      26,    63,    71,    78,    78,    72,     9,    17,    18,    35,
+      36,    37,    38,    39,    40,    19,    20,    15,    50,    51,
+      33,    44,    48,    78,    15,    16,    15,    64,    16,    15,
+      84,    14,    22,    24,    16,    16,    78,    78,     3,     4,
+      22,    23,    26,    14,    26,    53,     5,    25,    55,    10,
+      11,    12,    13,    67,    69,    69,    68,    68,    68,    68,
+      68,    68,    70,    70,    78,    78,    58,    58,     3,     4,
+      15,    45,    81,    78,    24,    78,    16,    78,    78,    24,
+      78,    78,    78,    78,    32,    79,    34,     3,    74,    21,
+      78,    24,    53,    26,    58,    34,    44,     3,    83,    78,
+      58,    14,    22,    34,     3,    47,    58,    34
+  };
+
+  const signed char
+  parser::yyr1_[] =
+  {
+       0,    56,    57,    58,    58,    58,    58,    58,    58,    59,
+      60,    60,    60,    60,    61,    61,    61,    62,    62,    63,
+      63,    64,    64,    64,    64,    64,    64,    65,    66,    66,
+      67,    67,    67,    67,    68,    68,    68,    68,    69,    69,
+      69,    70,    70,    70,    70,    70,    70,    70,    70,    70,
+      70,    70,    70,    71,    71,    72,    72,    72,    73,    73,
+      73,    74,    74,    75,    75,    75,    75,    76,    76,    76,
+      77,    78,    78,    78,    78,    78,    78,    78,    78,    78,
+      78,    79,    79,    80,    80,    81,    82,    83,    83,    83,
+      84,    84,    84
+  };
+
+  const signed char
+  parser::yyr2_[] =
+  {
+       0,     2,     1,     1,     1,     2,     2,     1,     2,     3,
+       1,     1,     1,     2,     2,     3,     4,     1,     1,     3,
+       1,     3,     3,     1,     6,     5,     5,     3,     3,     3,
+       1,     1,     1,     1,     1,     3,     3,     3,     1,     3,
+       3,     1,     1,     1,     1,     1,     1,     3,     3,     3,
+       2,     4,     3,     3,     5,     0,     2,     4,     3,     3,
+       2,     4,     4,     1,     1,     1,     1,     1,     1,     1,
+       6,     3,     3,     2,     3,     3,     3,     3,     3,     3,
+       1,     0,     2,     5,     8,     7,     4,     3,     1,     0,
+       3,     1,     0
+  };
+
+
+#if YYDEBUG || 1
+  // YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+  // First, the terminals, then, starting at \a YYNTOKENS, nonterminals.
+  const char*
+  const parser::yytname_[] =
+  {
+  "\"end of file\"", "error", "\"invalid token\"", "IDENTIFIER", "NUMBER",
+  "STRING", "BOOL", "VAR", "CONST", "IS", "NUMBER_TYPE", "STRING_TYPE",
+  "BOOL_TYPE", "NULL_TYPE", "COMMA", "SEMICOLON", "ASSIGN", "PLUS",
+  "MINUS", "MUL", "DIV", "LPAREN", "RPAREN", "LBRACKET", "RBRACKET",
+  "LBRACE", "RBRACE", "READ_INT", "READ_REAL", "READ_STRING", "PRINT",
+  "IF", "ELSE", "THEN", "END", "LESS", "LESS_E", "GREATER", "GREATER_E",
+  "EQUAL", "NOT_EQUAL", "NOT", "WHILE_L", "FOR_L", "LOOP", "FUNC",
+  "RETURN", "DO", "DOT_OP", "INVALID", "AND", "OR", "XOR", "COLON",
+  "INTERP_BEGIN", "INTERP_END", "$accept", "program", "block", "return",
+  "statement", "assignment", "declaration_specifics", "list_assignemtns",
+  "assignment_part", "assignment_value", "tuple_element",
+  "assignment_type", "expression", "term", "factor", "dict_entries",
+  "interpolation", "operation", "comp_expression", "operation_op",
+  "read_keyword", "if_statement", "conditional_expression",
+  "if_alternatives", "loop_statement", "function_declaration",
+  "function_call", "function_params", "function_call_params", YY_NULLPTR
+  };
+#endif
+
+
+#if YYDEBUG
+  const short
+  parser::yyrline_[] =
+  {
+       0,   113,   113,   117,   126,   127,   136,   137,   140,   146,
+     152,   153,   154,   155,   160,   161,   165,   173,   174,   178,
+     179,   183,   188,   193,   198,   202,   206,   213,   221,   226,
+     234,   235,   236,   237,   241,   242,   243,   244,   250,   251,
+     252,   256,   257,   258,   259,   260,   261,   262,   267,   268,
+     269,   270,   274,   279,   283,   290,   291,   292,   299,   300,
+     303,   307,   311,   317,   318,   319,   320,   324,   325,   326,
+     329,   335,   336,   337,   338,   339,   340,   341,   342,   343,
+     344,   348,   349,   353,   354,   362,   369,   381,   386,   391,
+     397,   401,   405
+  };
+
+  void
+  parser::yy_stack_print_ () const
+  {
+    *yycdebug_ << "Stack now";
+    for (stack_type::const_iterator
+           i = yystack_.begin (),
+           i_end = yystack_.end ();
+         i != i_end; ++i)
+      *yycdebug_ << ' ' << int (i->state);
+    *yycdebug_ << '\n';
+  }
+
+  void
+  parser::yy_reduce_print_ (int yyrule) const
+  {
+    int yylno = yyrline_[yyrule];
+    int yynrhs = yyr2_[yyrule];
+    // Print the symbols being reduced, and their result.
+    *yycdebug_ << "Reducing stack by rule " << yyrule - 1
+               << " (line " << yylno << "):\n";
+    // The symbols being reduced.
+    for (int yyi = 0; yyi < yynrhs; yyi++)
+      YY_SYMBOL_PRINT ("   $" << yyi + 1 << " =",
+                       yystack_[(yynrhs) - (yyi + 1)]);
+  }
+#endif // YYDEBUG
+
+
+} // yy
+#line 2076 "/root/repo/parser.tab.cpp"
+
+#line 410 "/root/repo/parser.ypp"
+
+
+namespace yy
+{
+    void parser::error(const std::string& msg) //(3+)
+    {
+        std::cout<< msg << '\n';
+    }
+}
+
+void dump(AST::ASTNode* n) {
+    std::cout << "*** Building: " << n->str() << std::endl;
+}
@@ -0,0 +1,2556 @@
+// A Bison parser, made by GNU Bison 3.8.2.
+
+// Skeleton interface for Bison LALR(1) parsers in C++
+
+// Copyright (C) 2002-2015, 2018-2021 Free Software Foundation, Inc.
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+// As a special exception, you may create a larger work that contains
+// part or all of the Bison parser skeleton and distribute that work
+// under terms of your choice, so long as that work isn't itself a
+// parser generator using the skeleton or a modified version thereof
+// as a parser skeleton.  Alternatively, if you modify or redistribute
+// the parser skeleton itself, you may (at your option) remove this
+// special exception, which will cause the skeleton and the resulting
+// Bison output files to be licensed under the GNU General Public
+// License without this special exception.
+
+// This special exception was added by the Free Software Foundation in
+// version 2.2 of Bison.
+
+
+/**
+ ** \file /root/repo/parser.tab.hpp
+ ** Define the yy::parser class.
+ */
+
+// C++ LALR(1) parser skeleton written by Akim Demaille.
+
+// DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+// especially those whose name start with YY_ or yy_.  They are
+// private implementation details that can be changed or removed.
+
+#ifndef YY_YY_ROOT_REPO_PARSER_TAB_HPP_INCLUDED
+# define YY_YY_ROOT_REPO_PARSER_TAB_HPP_INCLUDED
+// "%code requires" blocks.
+#line 11 "/root/repo/parser.ypp"
+
+    #pragma once
+    #include <iostream>
+    #include <string>
+	#include "ast.hpp"
+
+	using namespace std;
+    
+    // forward decleration (1)
+    namespace yy
+    {
+        class parser;
+    }
+
+#line 64 "/root/repo/parser.tab.hpp"
+
+# include <cassert>
+# include <cstdlib> // std::abort
+# include <iostream>
+# include <stdexcept>
+# include <string>
+# include <vector>
+
+#if defined __cplusplus
+# define YY_CPLUSPLUS __cplusplus
+#else
+# define YY_CPLUSPLUS 199711L
+#endif
+
+// Support move semantics when possible.
+#if 201103L <= YY_CPLUSPLUS
+# define YY_MOVE           std::move
+# define YY_MOVE_OR_COPY   move
+# define YY_MOVE_REF(Type) Type&&
+# define YY_RVREF(Type)    Type&&
+# define YY_COPY(Type)     Type
+#else
+# define YY_MOVE
+# define YY_MOVE_OR_COPY   copy
+# define YY_MOVE_REF(Type) Type&
+# define YY_RVREF(Type)    const Type&
+# define YY_COPY(Type)     const Type&
+#endif
+
+// Support noexcept when possible.
+#if 201103L <= YY_CPLUSPLUS
+# define YY_NOEXCEPT noexcept
+# define YY_NOTHROW
+#else
+# define YY_NOEXCEPT
+# define YY_NOTHROW throw ()
+#endif
+
+// Support constexpr when possible.
+#if 201703 <= YY_CPLUSPLUS
+# define YY_CONSTEXPR constexpr
+#else
+# define YY_CONSTEXPR
+#endif
+
+#include <typeinfo>
+#ifndef YY_ASSERT
+# include <cassert>
+# define YY_ASSERT assert
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+
+namespace yy {
+#line 204 "/root/repo/parser.tab.hpp"
+
+
+
+
+  /// A Bison parser.
+  class parser
+  {
+  public:
+#ifdef YYSTYPE
+# ifdef __GNUC__
+#  pragma GCC message "bison: do not #define YYSTYPE in C++, use %define api.value.type"
+# endif
+    typedef YYSTYPE value_type;
+#else
+  /// A buffer to store and retrieve objects.
+  ///
+  /// Sort of a variant, but does not keep track of the nature
+  /// of the stored data, since that knowledge is available
+  /// via the current parser state.
+  class value_type
+  {
+  public:
+    /// Type of *this.
+    typedef value_type self_type;
+
+    /// Empty construction.
+    value_type () YY_NOEXCEPT
+      : yyraw_ ()
+      , yytypeid_ (YY_NULLPTR)
+    {}
+
+    /// Construct and fill.
+    template <typename T>
+    value_type (YY_RVREF (T) t)
+      : yytypeid_ (&typeid (T))
+    {
+      YY_ASSERT (sizeof (T) <= size);
+      new (yyas_<T> ()) T (YY_MOVE (t));
+    }
+
+#if 201103L <= YY_CPLUSPLUS
+    /// Non copyable.
+    value_type (const self_type&) = delete;
+    /// Non copyable.
+    self_type& operator= (const self_type&) = delete;
+#endif
+
+    /// Destruction, allowed only if empty.
+    ~value_type () YY_NOEXCEPT
+    {
+      YY_ASSERT (!yytypeid_);
+    }
+
+# if 201103L <= YY_CPLUSPLUS
+    /// Instantiate a \a T in here from \a t.
+    template <typename T, typename... U>
+    T&
+    emplace (U&&... u)
+    {
+      YY_ASSERT (!yytypeid_);
+      YY_ASSERT (sizeof (T) <= size);
+      yytypeid_ = & typeid (T);
+      return *new (yyas_<T> ()) T (std::forward <U>(u)...);
+    }
+# else
+    /// Instantiate an empty \a T in here.
+    template <typename T>
+    T&
+    emplace ()
+    {
+      YY_ASSERT (!yytypeid_);
+      YY_ASSERT (sizeof (T) <= size);
+      yytypeid_ = & typeid (T);
+      return *new (yyas_<T> ()) T ();
+    }
+
+    /// Instantiate a \a T in here from \a t.
+    template <typename T>
+    T&
+    emplace (const T& t)
+    {
+      YY_ASSERT (!yytypeid_);
+      YY_ASSERT (sizeof (T) <= size);
+      yytypeid_ = & typeid (T);
+      return *new (yyas_<T> ()) T (t);
+    }
+# endif
+
+    /// Instantiate an empty \a T in here.
+    /// Obsolete, use emplace.
+    template <typename T>
+    T&
+    build ()
+    {
+      return emplace<T> ();
+    }
+
+    /// Instantiate a \a T in here from \a t.
+    /// Obsolete, use emplace.
+    template <typename T>
+    T&
+    build (const T& t)
+    {
+      return emplace<T> (t);
+    }
+
+    /// Accessor to a built \a T.
+    template <typename T>
+    T&
+    as () YY_NOEXCEPT
+    {
+      YY_ASSERT (yytypeid_);
+      YY_ASSERT (*yytypeid_ == typeid (T));
+      YY_ASSERT (sizeof (T) <= size);
+      return *yyas_<T> ();
+    }
+
+    /// Const accessor to a built \a T (for %printer).
+    template <typename T>
+    const T&
+    as () const YY_NOEXCEPT
+    {
+      YY_ASSERT (yytypeid_);
+      YY_ASSERT (*yytypeid_ == typeid (T));
+      YY_ASSERT (sizeof (T) <= size);
+      return *yyas_<T> ();
+    }
+
+    /// Swap the content with \a that, of same type.
+    ///
+    /// Both variants must be built beforehand, because swapping the actual
+    /// data requires reading it (with as()), and this is not possible on
+    /// unconstructed variants: it would require some dynamic testing, which
+    /// should not be the variant's responsibility.
+    /// Swapping between built and (possibly) non-built is done with
+    /// self_type::move ().
+    template <typename T>
+    void
+    swap (self_type& that) YY_NOEXCEPT
+    {
+      YY_ASSERT (yytypeid_);
+      YY_ASSERT (*yytypeid_ == *that.yytypeid_);
+      std::swap (as<T> (), that.as<T> ());
+    }
+
+    /// Move the content of \a that to this.
+    ///
+    /// Destroys \a that.
+    template <typename T>
+    void
+    move (self_type& that)
+    {
+# if 201103L <= YY_CPLUSPLUS
+      emplace<T> (std::move (that.as<T> ()));
+# else
+      emplace<T> ();
+      swap<T> (that);
+# endif
+      that.destroy<T> ();
+    }
+
+# if 201103L <= YY_CPLUSPLUS
+    /// Move the content of \a that to this.
+    template <typename T>
+    void
+    move (self_type&& that)
+    {
+      emplace<T> (std::move (that.as<T> ()));
+      that.destroy<T> ();
+    }
+#endif
+
+    /// Copy the content of \a that to this.
+    template <typename T>
+    void
+    copy (const self_type& that)
+    {
+      emplace<T> (that.as<T> ());
+    }
+
+    /// Destroy the stored \a T.
+    template <typename T>
+    void
+    destroy ()
+    {
+      as<T> ().~T ();
+      yytypeid_ = YY_NULLPTR;
+    }
+
+  private:
+#if YY_CPLUSPLUS < 201103L
+    /// Non copyable.
+    value_type (const self_type&);
+    /// Non copyable.
+    self_type& operator= (const self_type&);
+#endif
+
+    /// Accessor to raw memory as \a T.
+    template <typename T>
+    T*
+    yyas_ () YY_NOEXCEPT
+    {
+      void *yyp = yyraw_;
+      return static_cast<T*> (yyp);
+     }
+
+    /// Const accessor to raw memory as \a T.
+    template <typename T>
+    const T*
+    yyas_ () const YY_NOEXCEPT
+    {
+      const void *yyp = yyraw_;
+      return static_cast<const T*> (yyp);
+     }
+
+    /// An auxiliary type to compute the largest semantic type.
+    union union_type
+    {
+      // program
+      // return
+      // statement
+      // assignment_part
+      // assignment_value
+      // tuple_element
+      // assignment_type
+      // expression
+      // term
+      // factor
+      // operation
+      // comp_expression
+      // operation_op
+      // read_keyword
+      // if_statement
+      // conditional_expression
+      // loop_statement
+      // function_declaration
+      // function_call
+      char dummy1[sizeof (AST::ASTNode*)];
+
+      // declaration_specifics
+      char dummy2[sizeof (AST::AssignMod*)];
+
+      // block
+      // assignment
+      // list_assignemtns
+      // if_alternatives
+      // function_params
+      // function_call_params
+      char dummy3[sizeof (AST::Block*)];
+
+      // dict_entries
+      char dummy4[sizeof (AST::DictDecl*)];
+
+      // interpolation
+      char dummy5[sizeof (AST::Interpolation*)];
+
+      // IDENTIFIER
+      char dummy6[sizeof (Symbol)];
+
+      // NUMBER
+      // STRING
+      // BOOL
+      char dummy7[sizeof (string)];
+    };
+
+    /// The size of the largest semantic type.
+    enum { size = sizeof (union_type) };
+
+    /// A buffer to store semantic values.
+    union
+    {
+      /// Strongest alignment constraints.
+      long double yyalign_me_;
+      /// A buffer large enough to store any of the semantic values.
+      char yyraw_[size];
+    };
+
+    /// Whether the content is built: if defined, the name of the stored type.
+    const std::type_info *yytypeid_;
+  };
+
+#endif
+    /// Backward compatibility (Bison 3.8).
+    typedef value_type semantic_type;
+
+
+    /// Syntax errors thrown from user actions.
+    struct syntax_error : std::runtime_error
+    {
+      syntax_error (const std::string& m)
+        : std::runtime_error (m)
+      {}
+
+      syntax_error (const syntax_error& s)
+        : std::runtime_error (s.what ())
+      {}
+
+      ~syntax_error () YY_NOEXCEPT YY_NOTHROW;
+    };
+
+    /// Token kinds.
+    struct token
+    {
+      enum token_kind_type
+      {
+        YYEMPTY = -2,
+    EOF_ = 0,                      // "end of file"
+    YYerror = 256,                 // error
+    YYUNDEF = 257,                 // "invalid token"
+    IDENTIFIER = 258,              // IDENTIFIER
+    NUMBER = 259,                  // NUMBER
+    STRING = 260,                  // STRING
+    BOOL = 261,                    // BOOL
+    VAR = 262,                     // VAR
+    CONST = 263,                   // CONST
+    IS = 264,                      // IS
+    NUMBER_TYPE = 265,             // NUMBER_TYPE
+    STRING_TYPE = 266,             // STRING_TYPE
+    BOOL_TYPE = 267,               // BOOL_TYPE
+    NULL_TYPE = 268,               // NULL_TYPE
+    COMMA = 269,                   // COMMA
+    SEMICOLON = 270,               // SEMICOLON
+    ASSIGN = 271,                  // ASSIGN
+    PLUS = 272,                    // PLUS
+    MINUS = 273,                   // MINUS
+    MUL = 274,                     // MUL
+    DIV = 275,                     // DIV
+    LPAREN = 276,                  // LPAREN
+    RPAREN = 277,                  // RPAREN
+    LBRACKET = 278,                // LBRACKET
+    RBRACKET = 279,                // RBRACKET
+    LBRACE = 280,                  // LBRACE
+    RBRACE = 281,                  // RBRACE
+    READ_INT = 282,                // READ_INT
+    READ_REAL = 283,               // READ_REAL
+    READ_STRING = 284,             // READ_STRING
+    PRINT = 285,                   // PRINT
+    IF = 286,                      // IF
+    ELSE = 287,                    // ELSE
+    THEN = 288,                    // THEN
+    END = 289,                     // END
+    LESS = 290,                    // LESS
+    LESS_E = 291,                  // LESS_E
+    GREATER = 292,                 // GREATER
+    GREATER_E = 293,               // GREATER_E
+    EQUAL = 294,                   // EQUAL
+    NOT_EQUAL = 295,               // NOT_EQUAL
+    NOT = 296,                     // NOT
+    WHILE_L = 297,                 // WHILE_L
+    FOR_L = 298,                   // FOR_L
+    LOOP = 299,                    // LOOP
+    FUNC = 300,                    // FUNC
+    RETURN = 301,                  // RETURN
+    DO = 302,                      // DO
+    DOT_OP = 303,                  // DOT_OP
+    INVALID = 304,                 // INVALID
+    AND = 305,                     // AND
+    OR = 306,                      // OR
+    XOR = 307,                     // XOR
+    COLON = 308,                   // COLON
+    INTERP_BEGIN = 309,            // INTERP_BEGIN
+    INTERP_END = 310               // INTERP_END
+      };
+      /// Backward compatibility alias (Bison 3.6).
+      typedef token_kind_type yytokentype;
+    };
+
+    /// Token kind, as returned by yylex.
+    typedef token::token_kind_type token_kind_type;
+
+    /// Backward compatibility alias (Bison 3.6).
+    typedef token_kind_type token_type;
+
+    /// Symbol kinds.
+    struct symbol_kind
+    {
+      enum symbol_kind_type
+      {
+        YYNTOKENS = 56, ///< Number of tokens.
+        S_YYEMPTY = -2,
+        S_YYEOF = 0,                             // "end of file"
+        S_YYerror = 1,                           // error
+        S_YYUNDEF = 2,                           // "invalid token"
+        S_IDENTIFIER = 3,                        // IDENTIFIER
+        S_NUMBER = 4,                            // NUMBER
+        S_STRING = 5,                            // STRING
+        S_BOOL = 6,                              // BOOL
+        S_VAR = 7,                               // VAR
+        S_CONST = 8,                             // CONST
+        S_IS = 9,                                // IS
+        S_NUMBER_TYPE = 10,                      // NUMBER_TYPE
+        S_STRING_TYPE = 11,                      // STRING_TYPE
+        S_BOOL_TYPE = 12,                        // BOOL_TYPE
+        S_NULL_TYPE = 13,                        // NULL_TYPE
+        S_COMMA = 14,                            // COMMA
+        S_SEMICOLON = 15,                        // SEMICOLON
+        S_ASSIGN = 16,                           // ASSIGN
+        S_PLUS = 17,                             // PLUS
+        S_MINUS = 18,                            // MINUS
+        S_MUL = 19,                              // MUL
+        S_DIV = 20,                              // DIV
+        S_LPAREN = 21,                           // LPAREN
+        S_RPAREN = 22,                           // RPAREN
+        S_LBRACKET = 23,                         // LBRACKET
+        S_RBRACKET = 24,                         // RBRACKET
+        S_LBRACE = 25,                           // LBRACE
+        S_RBRACE = 26,                           // RBRACE
+        S_READ_INT = 27,                         // READ_INT
+        S_READ_REAL = 28,                        // READ_REAL
+        S_READ_STRING = 29,                      // READ_STRING
+        S_PRINT = 30,                            // PRINT
+        S_IF = 31,                               // IF
+        S_ELSE = 32,                             // ELSE
+        S_THEN = 33,                             // THEN
+        S_END = 34,                              // END
+        S_LESS = 35,                             // LESS
+        S_LESS_E = 36,                           // LESS_E
+        S_GREATER = 37,                          // GREATER
+        S_GREATER_E = 38,                        // GREATER_E
+        S_EQUAL = 39,                            // EQUAL
+        S_NOT_EQUAL = 40,                        // NOT_EQUAL
+        S_NOT = 41,                              // NOT
+        S_WHILE_L = 42,                          // WHILE_L
+        S_FOR_L = 43,                            // FOR_L
+        S_LOOP = 44,                             // LOOP
+        S_FUNC = 45,                             // FUNC
+        S_RETURN = 46,                           // RETURN
+        S_DO = 47,                               // DO
+        S_DOT_OP = 48,                           // DOT_OP
+        S_INVALID = 49,                          // INVALID
+        S_AND = 50,                              // AND
+        S_OR = 51,                               // OR
+        S_XOR = 52,                              // XOR
+        S_COLON = 53,                            // COLON
+        S_INTERP_BEGIN = 54,                     // INTERP_BEGIN
+        S_INTERP_END = 55,                       // INTERP_END
+        S_YYACCEPT = 56,                         // $accept
+        S_program = 57,                          // program
+        S_block = 58,                            // block
+        S_return = 59,                           // return
+        S_statement = 60,                        // statement
+        S_assignment = 61,                       // assignment
+        S_declaration_specifics = 62,            // declaration_specifics
+        S_list_assignemtns = 63,                 // list_assignemtns
+        S_assignment_part = 64,                  // assignment_part
+        S_assignment_value = 65,                 // assignment_value
+        S_tuple_element = 66,                    // tuple_element
+        S_assignment_type = 67,                  // assignment_type
+        S_expression = 68,                       // expression
+        S_term = 69,                             // term
+        S_factor = 70,                           // factor
+        S_dict_entries = 71,                     // dict_entries
+        S_interpolation = 72,                    // interpolation
+        S_operation = 73,                        // operation
+        S_comp_expression = 74,                  // comp_expression
+        S_operation_op = 75,                     // operation_op
+        S_read_keyword = 76,                     // read_keyword
+        S_if_statement = 77,                     // if_statement
+        S_conditional_expression = 78,           // conditional_expression
+        S_if_alternatives = 79,                  // if_alternatives
+        S_loop_statement = 80,                   // loop_statement
+        S_function_declaration = 81,             // function_declaration
+        S_function_call = 82,                    // function_call
+        S_function_params = 83,                  // function_params
+        S_function_call_params = 84              // function_call_params
+      };
+    };
+
+    /// (Internal) symbol kind.
+    typedef symbol_kind::symbol_kind_type symbol_kind_type;
+
+    /// The number of tokens.
+    static const symbol_kind_type YYNTOKENS = symbol_kind::YYNTOKENS;
+
+    /// A complete symbol.
+    ///
+    /// Expects its Base type to provide access to the symbol kind
+    /// via kind ().
+    ///
+    /// Provide access to semantic value.
+    template <typename Base>
+    struct basic_symbol : Base
+    {
+      /// Alias to Base.
+      typedef Base super_type;
+
+      /// Default constructor.
+      basic_symbol () YY_NOEXCEPT
+        : value ()
+      {}
+
+#if 201103L <= YY_CPLUSPLUS
+      /// Move constructor.
+      basic_symbol (basic_symbol&& that)
+        : Base (std::move (that))
+        , value ()
+      {
+        switch (this->kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.move< AST::ASTNode* > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.move< AST::AssignMod* > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.move< AST::Block* > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.move< AST::DictDecl* > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.move< AST::Interpolation* > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.move< Symbol > (std::move (that.value));
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.move< string > (std::move (that.value));
+        break;
+
+      default:
+        break;
+    }
+
+      }
+#endif
+
+      /// Copy constructor.
+      basic_symbol (const basic_symbol& that);
+
+      /// Constructors for typed symbols.
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t)
+        : Base (t)
+      {}
+#else
+      basic_symbol (typename Base::kind_type t)
+        : Base (t)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, AST::ASTNode*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const AST::ASTNode*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, AST::AssignMod*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const AST::AssignMod*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, AST::Block*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const AST::Block*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, AST::DictDecl*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const AST::DictDecl*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, AST::Interpolation*&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const AST::Interpolation*& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, Symbol&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const Symbol& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+#if 201103L <= YY_CPLUSPLUS
+      basic_symbol (typename Base::kind_type t, string&& v)
+        : Base (t)
+        , value (std::move (v))
+      {}
+#else
+      basic_symbol (typename Base::kind_type t, const string& v)
+        : Base (t)
+        , value (v)
+      {}
+#endif
+
+      /// Destroy the symbol.
+      ~basic_symbol ()
+      {
+        clear ();
+      }
+
+
+
+      /// Destroy contents, and record that is empty.
+      void clear () YY_NOEXCEPT
+      {
+        // User destructor.
+        symbol_kind_type yykind = this->kind ();
+        basic_symbol<Base>& yysym = *this;
+        (void) yysym;
+        switch (yykind)
+        {
+       default:
+          break;
+        }
+
+        // Value type destructor.
+switch (yykind)
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.template destroy< AST::ASTNode* > ();
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.template destroy< AST::AssignMod* > ();
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.template destroy< AST::Block* > ();
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.template destroy< AST::DictDecl* > ();
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.template destroy< AST::Interpolation* > ();
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.template destroy< Symbol > ();
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.template destroy< string > ();
+        break;
+
+      default:
+        break;
+    }
+
+        Base::clear ();
+      }
+
+      /// The user-facing name of this symbol.
+      std::string name () const YY_NOEXCEPT
+      {
+        return parser::symbol_name (this->kind ());
+      }
+
+      /// Backward compatibility (Bison 3.6).
+      symbol_kind_type type_get () const YY_NOEXCEPT;
+
+      /// Whether empty.
+      bool empty () const YY_NOEXCEPT;
+
+      /// Destructive move, \a s is emptied into this.
+      void move (basic_symbol& s);
+
+      /// The semantic value.
+      value_type value;
+
+    private:
+#if YY_CPLUSPLUS < 201103L
+      /// Assignment operator.
+      basic_symbol& operator= (const basic_symbol& that);
+#endif
+    };
+
+    /// Type access provider for token (enum) based symbols.
+    struct by_kind
+    {
+      /// The symbol kind as needed by the constructor.
+      typedef token_kind_type kind_type;
+
+      /// Default constructor.
+      by_kind () YY_NOEXCEPT;
+
+#if 201103L <= YY_CPLUSPLUS
+      /// Move constructor.
+      by_kind (by_kind&& that) YY_NOEXCEPT;
+#endif
+
+      /// Copy constructor.
+      by_kind (const by_kind& that) YY_NOEXCEPT;
+
+      /// Constructor from (external) token numbers.
+      by_kind (kind_type t) YY_NOEXCEPT;
+
+
+
+      /// Record that this symbol is empty.
+      void clear () YY_NOEXCEPT;
+
+      /// Steal the symbol kind from \a that.
+      void move (by_kind& that);
+
+      /// The (internal) type number (corresponding to \a type).
+      /// \a empty when empty.
+      symbol_kind_type kind () const YY_NOEXCEPT;
+
+      /// Backward compatibility (Bison 3.6).
+      symbol_kind_type type_get () const YY_NOEXCEPT;
+
+      /// The symbol kind.
+      /// \a S_YYEMPTY when empty.
+      symbol_kind_type kind_;
+    };
+
+    /// Backward compatibility for a private implementation detail (Bison 3.6).
+    typedef by_kind by_type;
+
+    /// "External" symbols: returned by the scanner.
+    struct symbol_type : basic_symbol<by_kind>
+    {
+      /// Superclass.
+      typedef basic_symbol<by_kind> super_type;
+
+      /// Empty symbol.
+      symbol_type () YY_NOEXCEPT {}
+
+      /// Constructor for valueless symbols, and symbols from each type.
+#if 201103L <= YY_CPLUSPLUS
+      symbol_type (int tok)
+        : super_type (token_kind_type (tok))
+#else
+      symbol_type (int tok)
+        : super_type (token_kind_type (tok))
+#endif
+      {
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::EOF_
+                   || (token::YYerror <= tok && tok <= token::YYUNDEF)
+                   || (token::VAR <= tok && tok <= token::INTERP_END));
+#endif
+      }
+#if 201103L <= YY_CPLUSPLUS
+      symbol_type (int tok, Symbol v)
+        : super_type (token_kind_type (tok), std::move (v))
+#else
+      symbol_type (int tok, const Symbol& v)
+        : super_type (token_kind_type (tok), v)
+#endif
+      {
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT (tok == token::IDENTIFIER);
+#endif
+      }
+#if 201103L <= YY_CPLUSPLUS
+      symbol_type (int tok, string v)
+        : super_type (token_kind_type (tok), std::move (v))
+#else
+      symbol_type (int tok, const string& v)
+        : super_type (token_kind_type (tok), v)
+#endif
+      {
+#if !defined _MSC_VER || defined __clang__
+        YY_ASSERT ((token::NUMBER <= tok && tok <= token::BOOL));
+#endif
+      }
+    };
+
+    /// Build a parser object.
+    parser (AST::ASTNode** ast_root_yyarg);
+    virtual ~parser ();
+
+#if 201103L <= YY_CPLUSPLUS
+    /// Non copyable.
+    parser (const parser&) = delete;
+    /// Non copyable.
+    parser& operator= (const parser&) = delete;
+#endif
+
+    /// Parse.  An alias for parse ().
+    /// \returns  0 iff parsing succeeded.
+    int operator() ();
+
+    /// Parse.
+    /// \returns  0 iff parsing succeeded.
+    virtual int parse ();
+
+#if YYDEBUG
+    /// The current debugging stream.
+    std::ostream& debug_stream () const YY_ATTRIBUTE_PURE;
+    /// Set the current debugging stream.
+    void set_debug_stream (std::ostream &);
+
+    /// Type for debugging levels.
+    typedef int debug_level_type;
+    /// The current debugging level.
+    debug_level_type debug_level () const YY_ATTRIBUTE_PURE;
+    /// Set the current debugging level.
+    void set_debug_level (debug_level_type l);
+#endif
+
+    /// Report a syntax error.
+    /// \param msg    a description of the syntax error.
+    virtual void error (const std::string& msg);
+
+    /// Report a syntax error.
+    void error (const syntax_error& err);
+
+    /// The user-facing name of the symbol whose (internal) number is
+    /// YYSYMBOL.  No bounds checking.
+    static std::string symbol_name (symbol_kind_type yysymbol);
+
+    // Implementation of make_symbol for each token kind.
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_EOF_ ()
+      {
+        return symbol_type (token::EOF_);
+      }
+#else
+      static
+      symbol_type
+      make_EOF_ ()
+      {
+        return symbol_type (token::EOF_);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_YYerror ()
+      {
+        return symbol_type (token::YYerror);
+      }
+#else
+      static
+      symbol_type
+      make_YYerror ()
+      {
+        return symbol_type (token::YYerror);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_YYUNDEF ()
+      {
+        return symbol_type (token::YYUNDEF);
+      }
+#else
+      static
+      symbol_type
+      make_YYUNDEF ()
+      {
+        return symbol_type (token::YYUNDEF);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_IDENTIFIER (Symbol v)
+      {
+        return symbol_type (token::IDENTIFIER, std::move (v));
+      }
+#else
+      static
+      symbol_type
+      make_IDENTIFIER (const Symbol& v)
+      {
+        return symbol_type (token::IDENTIFIER, v);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_NUMBER (string v)
+      {
+        return symbol_type (token::NUMBER, std::move (v));
+      }
+#else
+      static
+      symbol_type
+      make_NUMBER (const string& v)
+      {
+        return symbol_type (token::NUMBER, v);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_STRING (string v)
+      {
+        return symbol_type (token::STRING, std::move (v));
+      }
+#else
+      static
+      symbol_type
+      make_STRING (const string& v)
+      {
+        return symbol_type (token::STRING, v);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_BOOL (string v)
+      {
+        return symbol_type (token::BOOL, std::move (v));
+      }
+#else
+      static
+      symbol_type
+      make_BOOL (const string& v)
+      {
+        return symbol_type (token::BOOL, v);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_VAR ()
+      {
+        return symbol_type (token::VAR);
+      }
+#else
+      static
+      symbol_type
+      make_VAR ()
+      {
+        return symbol_type (token::VAR);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_CONST ()
+      {
+        return symbol_type (token::CONST);
+      }
+#else
+      static
+      symbol_type
+      make_CONST ()
+      {
+        return symbol_type (token::CONST);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_IS ()
+      {
+        return symbol_type (token::IS);
+      }
+#else
+      static
+      symbol_type
+      make_IS ()
+      {
+        return symbol_type (token::IS);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_NUMBER_TYPE ()
+      {
+        return symbol_type (token::NUMBER_TYPE);
+      }
+#else
+      static
+      symbol_type
+      make_NUMBER_TYPE ()
+      {
+        return symbol_type (token::NUMBER_TYPE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_STRING_TYPE ()
+      {
+        return symbol_type (token::STRING_TYPE);
+      }
+#else
+      static
+      symbol_type
+      make_STRING_TYPE ()
+      {
+        return symbol_type (token::STRING_TYPE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_BOOL_TYPE ()
+      {
+        return symbol_type (token::BOOL_TYPE);
+      }
+#else
+      static
+      symbol_type
+      make_BOOL_TYPE ()
+      {
+        return symbol_type (token::BOOL_TYPE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_NULL_TYPE ()
+      {
+        return symbol_type (token::NULL_TYPE);
+      }
+#else
+      static
+      symbol_type
+      make_NULL_TYPE ()
+      {
+        return symbol_type (token::NULL_TYPE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_COMMA ()
+      {
+        return symbol_type (token::COMMA);
+      }
+#else
+      static
+      symbol_type
+      make_COMMA ()
+      {
+        return symbol_type (token::COMMA);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_SEMICOLON ()
+      {
+        return symbol_type (token::SEMICOLON);
+      }
+#else
+      static
+      symbol_type
+      make_SEMICOLON ()
+      {
+        return symbol_type (token::SEMICOLON);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_ASSIGN ()
+      {
+        return symbol_type (token::ASSIGN);
+      }
+#else
+      static
+      symbol_type
+      make_ASSIGN ()
+      {
+        return symbol_type (token::ASSIGN);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_PLUS ()
+      {
+        return symbol_type (token::PLUS);
+      }
+#else
+      static
+      symbol_type
+      make_PLUS ()
+      {
+        return symbol_type (token::PLUS);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_MINUS ()
+      {
+        return symbol_type (token::MINUS);
+      }
+#else
+      static
+      symbol_type
+      make_MINUS ()
+      {
+        return symbol_type (token::MINUS);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_MUL ()
+      {
+        return symbol_type (token::MUL);
+      }
+#else
+      static
+      symbol_type
+      make_MUL ()
+      {
+        return symbol_type (token::MUL);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_DIV ()
+      {
+        return symbol_type (token::DIV);
+      }
+#else
+      static
+      symbol_type
+      make_DIV ()
+      {
+        return symbol_type (token::DIV);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_LPAREN ()
+      {
+        return symbol_type (token::LPAREN);
+      }
+#else
+      static
+      symbol_type
+      make_LPAREN ()
+      {
+        return symbol_type (token::LPAREN);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_RPAREN ()
+      {
+        return symbol_type (token::RPAREN);
+      }
+#else
+      static
+      symbol_type
+      make_RPAREN ()
+      {
+        return symbol_type (token::RPAREN);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_LBRACKET ()
+      {
+        return symbol_type (token::LBRACKET);
+      }
+#else
+      static
+      symbol_type
+      make_LBRACKET ()
+      {
+        return symbol_type (token::LBRACKET);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_RBRACKET ()
+      {
+        return symbol_type (token::RBRACKET);
+      }
+#else
+      static
+      symbol_type
+      make_RBRACKET ()
+      {
+        return symbol_type (token::RBRACKET);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_LBRACE ()
+      {
+        return symbol_type (token::LBRACE);
+      }
+#else
+      static
+      symbol_type
+      make_LBRACE ()
+      {
+        return symbol_type (token::LBRACE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_RBRACE ()
+      {
+        return symbol_type (token::RBRACE);
+      }
+#else
+      static
+      symbol_type
+      make_RBRACE ()
+      {
+        return symbol_type (token::RBRACE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_READ_INT ()
+      {
+        return symbol_type (token::READ_INT);
+      }
+#else
+      static
+      symbol_type
+      make_READ_INT ()
+      {
+        return symbol_type (token::READ_INT);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_READ_REAL ()
+      {
+        return symbol_type (token::READ_REAL);
+      }
+#else
+      static
+      symbol_type
+      make_READ_REAL ()
+      {
+        return symbol_type (token::READ_REAL);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_READ_STRING ()
+      {
+        return symbol_type (token::READ_STRING);
+      }
+#else
+      static
+      symbol_type
+      make_READ_STRING ()
+      {
+        return symbol_type (token::READ_STRING);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_PRINT ()
+      {
+        return symbol_type (token::PRINT);
+      }
+#else
+      static
+      symbol_type
+      make_PRINT ()
+      {
+        return symbol_type (token::PRINT);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_IF ()
+      {
+        return symbol_type (token::IF);
+      }
+#else
+      static
+      symbol_type
+      make_IF ()
+      {
+        return symbol_type (token::IF);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_ELSE ()
+      {
+        return symbol_type (token::ELSE);
+      }
+#else
+      static
+      symbol_type
+      make_ELSE ()
+      {
+        return symbol_type (token::ELSE);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_THEN ()
+      {
+        return symbol_type (token::THEN);
+      }
+#else
+      static
+      symbol_type
+      make_THEN ()
+      {
+        return symbol_type (token::THEN);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_END ()
+      {
+        return symbol_type (token::END);
+      }
+#else
+      static
+      symbol_type
+      make_END ()
+      {
+        return symbol_type (token::END);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_LESS ()
+      {
+        return symbol_type (token::LESS);
+      }
+#else
+      static
+      symbol_type
+      make_LESS ()
+      {
+        return symbol_type (token::LESS);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_LESS_E ()
+      {
+        return symbol_type (token::LESS_E);
+      }
+#else
+      static
+      symbol_type
+      make_LESS_E ()
+      {
+        return symbol_type (token::LESS_E);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_GREATER ()
+      {
+        return symbol_type (token::GREATER);
+      }
+#else
+      static
+      symbol_type
+      make_GREATER ()
+      {
+        return symbol_type (token::GREATER);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_GREATER_E ()
+      {
+        return symbol_type (token::GREATER_E);
+      }
+#else
+      static
+      symbol_type
+      make_GREATER_E ()
+      {
+        return symbol_type (token::GREATER_E);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_EQUAL ()
+      {
+        return symbol_type (token::EQUAL);
+      }
+#else
+      static
+      symbol_type
+      make_EQUAL ()
+      {
+        return symbol_type (token::EQUAL);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_NOT_EQUAL ()
+      {
+        return symbol_type (token::NOT_EQUAL);
+      }
+#else
+      static
+      symbol_type
+      make_NOT_EQUAL ()
+      {
+        return symbol_type (token::NOT_EQUAL);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_NOT ()
+      {
+        return symbol_type (token::NOT);
+      }
+#else
+      static
+      symbol_type
+      make_NOT ()
+      {
+        return symbol_type (token::NOT);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_WHILE_L ()
+      {
+        return symbol_type (token::WHILE_L);
+      }
+#else
+      static
+      symbol_type
+      make_WHILE_L ()
+      {
+        return symbol_type (token::WHILE_L);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_FOR_L ()
+      {
+        return symbol_type (token::FOR_L);
+      }
+#else
+      static
+      symbol_type
+      make_FOR_L ()
+      {
+        return symbol_type (token::FOR_L);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_LOOP ()
+      {
+        return symbol_type (token::LOOP);
+      }
+#else
+      static
+      symbol_type
+      make_LOOP ()
+      {
+        return symbol_type (token::LOOP);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_FUNC ()
+      {
+        return symbol_type (token::FUNC);
+      }
+#else
+      static
+      symbol_type
+      make_FUNC ()
+      {
+        return symbol_type (token::FUNC);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_RETURN ()
+      {
+        return symbol_type (token::RETURN);
+      }
+#else
+      static
+      symbol_type
+      make_RETURN ()
+      {
+        return symbol_type (token::RETURN);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_DO ()
+      {
+        return symbol_type (token::DO);
+      }
+#else
+      static
+      symbol_type
+      make_DO ()
+      {
+        return symbol_type (token::DO);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_DOT_OP ()
+      {
+        return symbol_type (token::DOT_OP);
+      }
+#else
+      static
+      symbol_type
+      make_DOT_OP ()
+      {
+        return symbol_type (token::DOT_OP);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_INVALID ()
+      {
+        return symbol_type (token::INVALID);
+      }
+#else
+      static
+      symbol_type
+      make_INVALID ()
+      {
+        return symbol_type (token::INVALID);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_AND ()
+      {
+        return symbol_type (token::AND);
+      }
+#else
+      static
+      symbol_type
+      make_AND ()
+      {
+        return symbol_type (token::AND);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_OR ()
+      {
+        return symbol_type (token::OR);
+      }
+#else
+      static
+      symbol_type
+      make_OR ()
+      {
+        return symbol_type (token::OR);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_XOR ()
+      {
+        return symbol_type (token::XOR);
+      }
+#else
+      static
+      symbol_type
+      make_XOR ()
+      {
+        return symbol_type (token::XOR);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_COLON ()
+      {
+        return symbol_type (token::COLON);
+      }
+#else
+      static
+      symbol_type
+      make_COLON ()
+      {
+        return symbol_type (token::COLON);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_INTERP_BEGIN ()
+      {
+        return symbol_type (token::INTERP_BEGIN);
+      }
+#else
+      static
+      symbol_type
+      make_INTERP_BEGIN ()
+      {
+        return symbol_type (token::INTERP_BEGIN);
+      }
+#endif
+#if 201103L <= YY_CPLUSPLUS
+      static
+      symbol_type
+      make_INTERP_END ()
+      {
+        return symbol_type (token::INTERP_END);
+      }
+#else
+      static
+      symbol_type
+      make_INTERP_END ()
+      {
+        return symbol_type (token::INTERP_END);
+      }
+#endif
+
+
+    class context
+    {
+    public:
+      context (const parser& yyparser, const symbol_type& yyla);
+      const symbol_type& lookahead () const YY_NOEXCEPT { return yyla_; }
+      symbol_kind_type token () const YY_NOEXCEPT { return yyla_.kind (); }
+      /// Put in YYARG at most YYARGN of the expected tokens, and return the
+      /// number of tokens stored in YYARG.  If YYARG is null, return the
+      /// number of expected tokens (guaranteed to be less than YYNTOKENS).
+      int expected_tokens (symbol_kind_type yyarg[], int yyargn) const;
+
+    private:
+      const parser& yyparser_;
+      const symbol_type& yyla_;
+    };
+
+  private:
+#if YY_CPLUSPLUS < 201103L
+    /// Non copyable.
+    parser (const parser&);
+    /// Non copyable.
+    parser& operator= (const parser&);
+#endif
+
+
+    /// Stored state numbers (used for stacks).
+    typedef unsigned char state_type;
+
+    /// The arguments of the error message.
+    int yy_syntax_error_arguments_ (const context& yyctx,
+                                    symbol_kind_type yyarg[], int yyargn) const;
+
+    /// Generate an error message.
+    /// \param yyctx     the context in which the error occurred.
+    virtual std::string yysyntax_error_ (const context& yyctx) const;
+    /// Compute post-reduction state.
+    /// \param yystate   the current state
+    /// \param yysym     the nonterminal to push on the stack
+    static state_type yy_lr_goto_state_ (state_type yystate, int yysym);
+
+    /// Whether the given \c yypact_ value indicates a defaulted state.
+    /// \param yyvalue   the value to check
+    static bool yy_pact_value_is_default_ (int yyvalue) YY_NOEXCEPT;
+
+    /// Whether the given \c yytable_ value indicates a syntax error.
+    /// \param yyvalue   the value to check
+    static bool yy_table_value_is_error_ (int yyvalue) YY_NOEXCEPT;
+
+    static const signed char yypact_ninf_;
+    static const signed char yytable_ninf_;
+
+    /// Convert a scanner token kind \a t to a symbol kind.
+    /// In theory \a t should be a token_kind_type, but character literals
+    /// are valid, yet not members of the token_kind_type enum.
+    static symbol_kind_type yytranslate_ (int t) YY_NOEXCEPT;
+
+    /// Convert the symbol name \a n to a form suitable for a diagnostic.
+    static std::string yytnamerr_ (const char *yystr);
+
+    /// For a symbol, its name in clear.
+    static const char* const yytname_[];
+
+
+    // Tables.
+    // YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+    // STATE-NUM.
+    static const short yypact_[];
+
+    // YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+    // Performed when YYTABLE does not specify something else to do.  Zero
+    // means the default is an error.
+    static const signed char yydefact_[];
+
+    // YYPGOTO[NTERM-NUM].
+    static const short yypgoto_[];
+
+    // YYDEFGOTO[NTERM-NUM].
+    static const unsigned char yydefgoto_[];
+
+    // YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+    // positive, shift that token.  If negative, reduce the rule whose
+    // number is the opposite.  If YYTABLE_NINF, syntax error.
+    static const short yytable_[];
+
+    static const short yycheck_[];
+
+    // YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+    // state STATE-NUM.
+    static const signed char yystos_[];
+
+    // YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.
+    static const signed char yyr1_[];
+
+    // YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.
+    static const signed char yyr2_[];
+
+
+#if YYDEBUG
+    // YYRLINE[YYN] -- Source line where rule number YYN was defined.
+    static const short yyrline_[];
+    /// Report on the debug stream that the rule \a r is going to be reduced.
+    virtual void yy_reduce_print_ (int r) const;
+    /// Print the state stack on the debug stream.
+    virtual void yy_stack_print_ () const;
+
+    /// Debugging level.
+    int yydebug_;
+    /// Debug stream.
+    std::ostream* yycdebug_;
+
+    /// \brief Display a symbol kind, value and location.
+    /// \param yyo    The output stream.
+    /// \param yysym  The symbol.
+    template <typename Base>
+    void yy_print_ (std::ostream& yyo, const basic_symbol<Base>& yysym) const;
+#endif
+
+    /// \brief Reclaim the memory associated to a symbol.
+    /// \param yymsg     Why this token is reclaimed.
+    ///                  If null, print nothing.
+    /// \param yysym     The symbol.
+    template <typename Base>
+    void yy_destroy_ (const char* yymsg, basic_symbol<Base>& yysym) const;
+
+  private:
+    /// Type access provider for state based symbols.
+    struct by_state
+    {
+      /// Default constructor.
+      by_state () YY_NOEXCEPT;
+
+      /// The symbol kind as needed by the constructor.
+      typedef state_type kind_type;
+
+      /// Constructor.
+      by_state (kind_type s) YY_NOEXCEPT;
+
+      /// Copy constructor.
+      by_state (const by_state& that) YY_NOEXCEPT;
+
+      /// Record that this symbol is empty.
+      void clear () YY_NOEXCEPT;
+
+      /// Steal the symbol kind from \a that.
+      void move (by_state& that);
+
+      /// The symbol kind (corresponding to \a state).
+      /// \a symbol_kind::S_YYEMPTY when empty.
+      symbol_kind_type kind () const YY_NOEXCEPT;
+
+      /// The state number used to denote an empty symbol.
+      /// We use the initial state, as it does not have a value.
+      enum { empty_state = 0 };
+
+      /// The state.
+      /// \a empty when empty.
+      state_type state;
+    };
+
+    /// "Internal" symbol: element of the stack.
+    struct stack_symbol_type : basic_symbol<by_state>
+    {
+      /// Superclass.
+      typedef basic_symbol<by_state> super_type;
+      /// Construct an empty symbol.
+      stack_symbol_type ();
+      /// Move or copy construction.
+      stack_symbol_type (YY_RVREF (stack_symbol_type) that);
+      /// Steal the contents from \a sym to build this.
+      stack_symbol_type (state_type s, YY_MOVE_REF (symbol_type) sym);
+#if YY_CPLUSPLUS < 201103L
+      /// Assignment, needed by push_back by some old implementations.
+      /// Moves the contents of that.
+      stack_symbol_type& operator= (stack_symbol_type& that);
+
+      /// Assignment, needed by push_back by other implementations.
+      /// Needed by some other old implementations.
+      stack_symbol_type& operator= (const stack_symbol_type& that);
+#endif
+    };
+
+    /// A stack with random access from its top.
+    template <typename T, typename S = std::vector<T> >
+    class stack
+    {
+    public:
+      // Hide our reversed order.
+      typedef typename S::iterator iterator;
+      typedef typename S::const_iterator const_iterator;
+      typedef typename S::size_type size_type;
+      typedef typename std::ptrdiff_t index_type;
+
+      stack (size_type n = 200) YY_NOEXCEPT
+        : seq_ (n)
+      {}
+
+#if 201103L <= YY_CPLUSPLUS
+      /// Non copyable.
+      stack (const stack&) = delete;
+      /// Non copyable.
+      stack& operator= (const stack&) = delete;
+#endif
+
+      /// Random access.
+      ///
+      /// Index 0 returns the topmost element.
+      const T&
+      operator[] (index_type i) const
+      {
+        return seq_[size_type (size () - 1 - i)];
+      }
+
+      /// Random access.
+      ///
+      /// Index 0 returns the topmost element.
+      T&
+      operator[] (index_type i)
+      {
+        return seq_[size_type (size () - 1 - i)];
+      }
+
+      /// Steal the contents of \a t.
+      ///
+      /// Close to move-semantics.
+      void
+      push (YY_MOVE_REF (T) t)
+      {
+        seq_.push_back (T ());
+        operator[] (0).move (t);
+      }
+
+      /// Pop elements from the stack.
+      void
+      pop (std::ptrdiff_t n = 1) YY_NOEXCEPT
+      {
+        for (; 0 < n; --n)
+          seq_.pop_back ();
+      }
+
+      /// Pop all elements from the stack.
+      void
+      clear () YY_NOEXCEPT
+      {
+        seq_.clear ();
+      }
+
+      /// Number of elements on the stack.
+      index_type
+      size () const YY_NOEXCEPT
+      {
+        return index_type (seq_.size ());
+      }
+
+      /// Iterator on top of the stack (going downwards).
+      const_iterator
+      begin () const YY_NOEXCEPT
+      {
+        return seq_.begin ();
+      }
+
+      /// Bottom of the stack.
+      const_iterator
+      end () const YY_NOEXCEPT
+      {
+        return seq_.end ();
+      }
+
+      /// Present a slice of the top of a stack.
+      class slice
+      {
+      public:
+        slice (const stack& stack, index_type range) YY_NOEXCEPT
+          : stack_ (stack)
+          , range_ (range)
+        {}
+
+        const T&
+        operator[] (index_type i) const
+        {
+          return stack_[range_ - i];
+        }
+
+      private:
+        const stack& stack_;
+        index_type range_;
+      };
+
+    private:
+#if YY_CPLUSPLUS < 201103L
+      /// Non copyable.
+      stack (const stack&);
+      /// Non copyable.
+      stack& operator= (const stack&);
+#endif
+      /// The wrapped container.
+      S seq_;
+    };
+
+
+    /// Stack type.
+    typedef stack<stack_symbol_type> stack_type;
+
+    /// The stack.
+    stack_type yystack_;
+
+    /// Push a new state on the stack.
+    /// \param m    a debug message to display
+    ///             if null, no trace is output.
+    /// \param sym  the symbol
+    /// \warning the contents of \a s.value is stolen.
+    void yypush_ (const char* m, YY_MOVE_REF (stack_symbol_type) sym);
+
+    /// Push a new look ahead token on the state on the stack.
+    /// \param m    a debug message to display
+    ///             if null, no trace is output.
+    /// \param s    the state
+    /// \param sym  the symbol (for its value and location).
+    /// \warning the contents of \a sym.value is stolen.
+    void yypush_ (const char* m, state_type s, YY_MOVE_REF (symbol_type) sym);
+
+    /// Pop \a n symbols from the stack.
+    void yypop_ (int n = 1) YY_NOEXCEPT;
+
+    /// Constants.
+    enum
+    {
+      yylast_ = 388,     ///< Last index in yytable_.
+      yynnts_ = 29,  ///< Number of nonterminal symbols.
+      yyfinal_ = 55 ///< Termination state number.
+    };
+
+
+    // User arguments.
+    AST::ASTNode** ast_root;
+
+  };
+
+  inline
+  parser::symbol_kind_type
+  parser::yytranslate_ (int t) YY_NOEXCEPT
+  {
+    // YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to
+    // TOKEN-NUM as returned by yylex.
+    static
+    const signed char
+    translate_table[] =
+    {
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55
+    };
+    // Last valid token kind.
+    const int code_max = 310;
+
+    if (t <= 0)
+      return symbol_kind::S_YYEOF;
+    else if (t <= code_max)
+      return static_cast <symbol_kind_type> (translate_table[t]);
+    else
+      return symbol_kind::S_YYUNDEF;
+  }
+
+  // basic_symbol.
+  template <typename Base>
+  parser::basic_symbol<Base>::basic_symbol (const basic_symbol& that)
+    : Base (that)
+    , value ()
+  {
+    switch (this->kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.copy< AST::ASTNode* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.copy< AST::AssignMod* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.copy< AST::Block* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.copy< AST::DictDecl* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.copy< AST::Interpolation* > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.copy< Symbol > (YY_MOVE (that.value));
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.copy< string > (YY_MOVE (that.value));
+        break;
+
+      default:
+        break;
+    }
+
+  }
+
+
+
+
+  template <typename Base>
+  parser::symbol_kind_type
+  parser::basic_symbol<Base>::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
+
+
+  template <typename Base>
+  bool
+  parser::basic_symbol<Base>::empty () const YY_NOEXCEPT
+  {
+    return this->kind () == symbol_kind::S_YYEMPTY;
+  }
+
+  template <typename Base>
+  void
+  parser::basic_symbol<Base>::move (basic_symbol& s)
+  {
+    super_type::move (s);
+    switch (this->kind ())
+    {
+      case symbol_kind::S_program: // program
+      case symbol_kind::S_return: // return
+      case symbol_kind::S_statement: // statement
+      case symbol_kind::S_assignment_part: // assignment_part
+      case symbol_kind::S_assignment_value: // assignment_value
+      case symbol_kind::S_tuple_element: // tuple_element
+      case symbol_kind::S_assignment_type: // assignment_type
+      case symbol_kind::S_expression: // expression
+      case symbol_kind::S_term: // term
+      case symbol_kind::S_factor: // factor
+      case symbol_kind::S_operation: // operation
+      case symbol_kind::S_comp_expression: // comp_expression
+      case symbol_kind::S_operation_op: // operation_op
+      case symbol_kind::S_read_keyword: // read_keyword
+      case symbol_kind::S_if_statement: // if_statement
+      case symbol_kind::S_conditional_expression: // conditional_expression
+      case symbol_kind::S_loop_statement: // loop_statement
+      case symbol_kind::S_function_declaration: // function_declaration
+      case symbol_kind::S_function_call: // function_call
+        value.move< AST::ASTNode* > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_declaration_specifics: // declaration_specifics
+        value.move< AST::AssignMod* > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_block: // block
+      case symbol_kind::S_assignment: // assignment
+      case symbol_kind::S_list_assignemtns: // list_assignemtns
+      case symbol_kind::S_if_alternatives: // if_alternatives
+      case symbol_kind::S_function_params: // function_params
+      case symbol_kind::S_function_call_params: // function_call_params
+        value.move< AST::Block* > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_dict_entries: // dict_entries
+        value.move< AST::DictDecl* > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_interpolation: // interpolation
+        value.move< AST::Interpolation* > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_IDENTIFIER: // IDENTIFIER
+        value.move< Symbol > (YY_MOVE (s.value));
+        break;
+
+      case symbol_kind::S_NUMBER: // NUMBER
+      case symbol_kind::S_STRING: // STRING
+      case symbol_kind::S_BOOL: // BOOL
+        value.move< string > (YY_MOVE (s.value));
+        break;
+
+      default:
+        break;
+    }
+
+  }
+
+  // by_kind.
+  inline
+  parser::by_kind::by_kind () YY_NOEXCEPT
+    : kind_ (symbol_kind::S_YYEMPTY)
+  {}
+
+#if 201103L <= YY_CPLUSPLUS
+  inline
+  parser::by_kind::by_kind (by_kind&& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
+  {
+    that.clear ();
+  }
+#endif
+
+  inline
+  parser::by_kind::by_kind (const by_kind& that) YY_NOEXCEPT
+    : kind_ (that.kind_)
+  {}
+
+  inline
+  parser::by_kind::by_kind (token_kind_type t) YY_NOEXCEPT
+    : kind_ (yytranslate_ (t))
+  {}
+
+
+
+  inline
+  void
+  parser::by_kind::clear () YY_NOEXCEPT
+  {
+    kind_ = symbol_kind::S_YYEMPTY;
+  }
+
+  inline
+  void
+  parser::by_kind::move (by_kind& that)
+  {
+    kind_ = that.kind_;
+    that.clear ();
+  }
+
+  inline
+  parser::symbol_kind_type
+  parser::by_kind::kind () const YY_NOEXCEPT
+  {
+    return kind_;
+  }
+
+
+  inline
+  parser::symbol_kind_type
+  parser::by_kind::type_get () const YY_NOEXCEPT
+  {
+    return this->kind ();
+  }
+
+
+} // yy
+#line 2552 "/root/repo/parser.tab.hpp"
+
+
+
+
+#endif // !YY_YY_ROOT_REPO_PARSER_TAB_HPP_INCLUDED
@@ -0,0 +1,22 @@
+#!/bin/bash
+
+# Compares `+` chain with interpolated string literal
+#
+# usage: bench_format.sh <compiler>
+
+EXEC=$1
+DIR=$(dirname "$0")/../bench
+
+run_time() {
+    local start end
+    start=$(date +%s.%N)
+    $EXEC "$1" >/dev/null
+    end=$(date +%s.%N)
+    awk "BEGIN { print $end - $start }"
+}
+
+CONCAT=$(run_time "$DIR/format_concat.nnl")
+INTERP=$(run_time "$DIR/format_interp.nnl")
+printf "concat       %7.3f s\n" "$CONCAT"
+printf "interpolated %7.3f s\n" "$INTERP"
+printf "speedup      %7.1f\n" "$(awk "BEGIN { print $CONCAT / $INTERP }")"
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Runs parallel builtins benchmark with 1..N worker threads
+# and prints speedup against a single thread
+#
+# usage: bench_par.sh <compiler> [max threads] [script]
+
+EXEC=$1
+MAX=${2:-$(nproc)}
+SCRIPT=${3:-$(dirname "$0")/../bench/par_map.nnl}
+
+run_time() {
+    local start end
+    start=$(date +%s.%N)
+    NNL_THREADS=$1 $EXEC "$SCRIPT" >/dev/null
+    end=$(date +%s.%N)
+    awk "BEGIN { print $end - $start }"
+}
+
+BASE=$(run_time 1)
+printf "threads  seconds  speedup\n"
+printf "%7d  %7.3f  %7.2f\n" 1 "$BASE" 1
+for ((n = 2; n <= MAX; n++)); do
+    T=$(run_time $n)
+    printf "%7d  %7.3f  %7.2f\n" "$n" "$T" "$(awk "BEGIN { print $BASE / $T }")"
+done
@@ -0,0 +1,22 @@
+#!/bin/bash
+
+# Compares bubble sort written in script with `sort` builtin
+#
+# usage: bench_sort.sh <compiler>
+
+EXEC=$1
+DIR=$(dirname "$0")/../bench
+
+run_time() {
+    local start end
+    start=$(date +%s.%N)
+    $EXEC "$1" >/dev/null
+    end=$(date +%s.%N)
+    awk "BEGIN { print $end - $start }"
+}
+
+SCRIPT=$(run_time "$DIR/sort_script.nnl")
+NATIVE=$(run_time "$DIR/sort_native.nnl")
+printf "script sort  %7.3f s\n" "$SCRIPT"
+printf "sort builtin %7.3f s\n" "$NATIVE"
+printf "speedup      %7.1f\n" "$(awk "BEGIN { print $SCRIPT / $NATIVE }")"
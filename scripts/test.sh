@@ -12,6 +12,16 @@ get_test_expect() {
     cat "$FILE" | grep "#!expect" | sed 's/#!expect //g'
 }
 
+get_test_args() {
+    FILE=$1
+    cat "$FILE" | grep "#!args" | sed 's/#!args //g'
+}
+
+get_test_stdin() {
+    FILE=$1
+    cat "$FILE" | grep "#!stdin" | sed 's/#!stdin //g'
+}
+
 EXEC=$1
 TESTDIR=$2
 EXTENSION="nnl"
@@ -27,7 +37,9 @@ for test_file in $(find $TESTDIR -name "*.$EXTENSION"); do
     echo "Test: $test_name"
 
     EXPECT=$(get_test_expect $test_file)
-    ACTUAL=$($EXEC $test_file 2>&1)
+    ARGS=$(get_test_args $test_file)
+    STDIN=$(get_test_stdin $test_file)
+    ACTUAL=$($EXEC $ARGS $test_file <"${STDIN:-/dev/null}" 2>&1)
 
     if [[ "$EXPECT" == "$ACTUAL" ]]; then
         echo "Status: OK"
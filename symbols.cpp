@@ -0,0 +1,107 @@
+#include "symbols.hpp"
+
+#include <atomic>
+#include <functional>
+#include <iostream>
+
+/**************************************************
+ *           SymbolTable Implementation
+ **************************************************/
+
+SymbolTable::SymbolTable()
+    : blocks(new std::unique_ptr<Entry[]>[MAX_BLOCKS]),
+      count(0),
+      concurrent(false),
+      slots(64, 0) {
+  // symbol 0 is reserved for empty name
+  slots[find_slot("")] = add("") + 1;
+}
+
+SymbolTable &SymbolTable::global() {
+  static SymbolTable table;
+  return table;
+}
+
+size_t SymbolTable::find_slot(std::string_view name) const {
+  size_t mask = slots.size() - 1;
+  size_t i = std::hash<std::string_view>()(name) & mask;
+
+  // linear probing until name or empty slot is met
+  while (slots[i] && entry(slots[i] - 1).name != name) i = (i + 1) & mask;
+  return i;
+}
+
+void SymbolTable::grow() {
+  std::vector<uint32_t> old(slots.size() * 2, 0);
+  old.swap(slots);
+
+  for (uint32_t symbol : old) {
+    if (symbol) slots[find_slot(entry(symbol - 1).name)] = symbol;
+  }
+}
+
+Symbol SymbolTable::add(std::string_view name) {
+  if (count == MAX_BLOCKS * BLOCK_SIZE) {
+    std::cout << "Too many names. Aborting.\n";
+    exit(1);
+  }
+
+  Symbol symbol = count;
+  std::unique_ptr<Entry[]> &block = blocks[symbol >> BLOCK_BITS];
+  if (!block) block.reset(new Entry[BLOCK_SIZE]);
+
+  Entry &added = block[symbol & (BLOCK_SIZE - 1)];
+  added.name = name;
+  size_t at = name.find('@');
+  added.element = at != std::string_view::npos && at > 0 && at + 1 < name.size();
+
+  ++count;
+  return symbol;
+}
+
+Symbol SymbolTable::intern(std::string_view name) {
+  if (name.empty()) return 0;
+
+  std::unique_lock<std::mutex> guard(lock, std::defer_lock);
+  if (concurrent) guard.lock();
+
+  size_t i = find_slot(name);
+  if (slots[i]) return slots[i] - 1;
+
+  Symbol symbol = add(name);
+  slots[i] = symbol + 1;
+  // keep load factor below 1/2
+  if (count * 2 > slots.size()) grow();
+
+  return symbol;
+}
+
+bool SymbolTable::lookup(std::string_view name, Symbol &symbol) const {
+  std::unique_lock<std::mutex> guard(lock, std::defer_lock);
+  if (concurrent) guard.lock();
+
+  size_t i = find_slot(name);
+  if (!slots[i]) return false;
+
+  symbol = slots[i] - 1;
+  return true;
+}
+
+void SymbolTable::set_concurrent(bool on) { concurrent = on; }
+
+size_t SymbolTable::size() const { return count; }
+
+Symbol index_symbol(size_t index) {
+  // keys of small indices are interned once (without text)
+  static const size_t SMALL_KEYS = 4096;
+  static std::atomic<Symbol> small_keys[SMALL_KEYS];
+
+  if (index >= SMALL_KEYS) return intern(std::to_string(index));
+
+  Symbol key = small_keys[index].load(std::memory_order_relaxed);
+  if (!key) {
+    key = intern(std::to_string(index));
+    small_keys[index].store(key, std::memory_order_relaxed);
+  }
+  return key;
+}
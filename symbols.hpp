@@ -0,0 +1,114 @@
+#ifndef SYMBOLS_HPP
+#define SYMBOLS_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Interned name (identifier, tuple field or array key)
+ *
+ * Equal names always have equal symbols, so names are
+ * compared as integers. Symbol 0 is an empty name
+ * (used by temporary objects)
+ */
+typedef uint32_t Symbol;
+
+/**
+ * @brief Table of interned names
+ *
+ * Identifiers are interned once by lexer, everything
+ * downstream (AST, MemoryKernel) works with symbols.
+ * Names are never removed, so symbol stays valid
+ * until the end of program.
+ *
+ * Names are read without locks (entries never move). While
+ * concurrent mode is on (parallel builtins are running),
+ * adding and looking up names is serialized by mutex.
+ *
+ */
+class SymbolTable {
+ private:
+  struct Entry {
+    std::string name;
+    // name has ARRAY_NAME@ELEMENT_NAME form
+    bool element;
+  };
+
+  // entries are stored in blocks which are never moved or freed,
+  // so references stay valid and readers need no lock
+  static const size_t BLOCK_BITS = 10;
+  static const size_t BLOCK_SIZE = 1 << BLOCK_BITS;
+  static const size_t MAX_BLOCKS = 1 << 14;
+  std::unique_ptr<std::unique_ptr<Entry[]>[]> blocks;
+  size_t count;
+
+  // serializes `intern` and `lookup` in concurrent mode
+  mutable std::mutex lock;
+  bool concurrent;
+
+  // open addressing hash table of (symbol + 1), 0 marks empty slot
+  std::vector<uint32_t> slots;
+
+  const Entry &entry(Symbol symbol) const {
+    return blocks[symbol >> BLOCK_BITS][symbol & (BLOCK_SIZE - 1)];
+  }
+
+  size_t find_slot(std::string_view name) const;
+  void grow();
+  Symbol add(std::string_view name);
+
+ public:
+  SymbolTable();
+
+  // table shared by the whole interpreter
+  static SymbolTable &global();
+
+  /**
+   * @brief Get symbol of name, name is added if it is new
+   *
+   * @param name Name to intern
+   * @return Symbol of name
+   */
+  Symbol intern(std::string_view name);
+
+  /**
+   * @brief Find symbol of name without adding it
+   *
+   * @param name Name to look for
+   * @param symbol Receives symbol if name is known
+   * @return true if name was interned before
+   */
+  bool lookup(std::string_view name, Symbol &symbol) const;
+
+  // name of symbol
+  const std::string &name(Symbol symbol) const { return entry(symbol).name; }
+
+  // checks if name of symbol satisfies ARRAY_NAME@ELEMENT_NAME pattern
+  bool is_array_element(Symbol symbol) const { return entry(symbol).element; }
+
+  /**
+   * @brief Switch concurrent mode, should be on while several
+   *        threads may intern names
+   */
+  void set_concurrent(bool on);
+
+  // number of interned names
+  size_t size() const;
+};
+
+inline Symbol intern(std::string_view name) {
+  return SymbolTable::global().intern(name);
+}
+
+// symbol of array index key ("0", "1", ...), small indices are cached
+Symbol index_symbol(size_t index);
+
+inline const std::string &symbol_name(Symbol symbol) {
+  return SymbolTable::global().name(symbol);
+}
+
+#endif  // SYMBOLS_HPP
@@ -0,0 +1,102 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "../../MemoryKernel.hpp"
+
+using namespace std;
+
+/**************************************************
+ *        Allocation counter and test macros
+ **************************************************/
+
+// number of calls to global operator new since program start
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  ++allocations;
+  if (void *p = malloc(size ? size : 1)) return p;
+  throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+#define _INIT __attribute__((constructor(0)))
+#define _TEST __attribute__((constructor(10)))
+
+#define TEST_BEGIN() cout << "\n=== " << __func__ << " begin ===\n"
+#define TEST_END() cout << "=== " << __func__ << " end ===\n"
+
+static int failures = 0;
+
+_INIT void init_tests() { static std::ios_base::Init _; }
+
+// run `expr` and check that it did not allocate
+#define EXPECT_NO_ALLOC(expr)                                     \
+  do {                                                            \
+    size_t before = allocations;                                  \
+    expr;                                                         \
+    size_t made = allocations - before;                           \
+    cout << (made ? "FAIL " : "ok   ") << #expr;                  \
+    if (made) cout << " (" << made << " allocations)", ++failures; \
+    cout << "\n";                                                 \
+  } while (0)
+
+/**************************************************
+ *                  Tests Begin
+ **************************************************/
+
+_TEST void lookup_existing_names() {
+  TEST_BEGIN();
+  MemoryKernel mem;
+  mem.enter_scope();
+
+  mem.put_object(new MemObject(OBJECT_NUMBER, "a_rather_long_variable_name",
+                               "100.3"));
+  mem.put_object(new MemObject(OBJECT_STRING, "s", "some string value"));
+  mem.enter_scope();
+  mem.put_object(new MemObject(OBJECT_BOOL, "flag", "true"));
+  mem.put_object(new MemObject(OBJECT_NUMBER, "arr@0", "1"));
+  mem.put_object(new MemObject(OBJECT_NUMBER, "arr@first_element", "2"));
+
+  const MemObject *obj = nullptr;
+  Symbol s = intern("s");
+
+  EXPECT_NO_ALLOC(obj = mem.get_object("a_rather_long_variable_name"));
+  EXPECT_NO_ALLOC(obj = mem.get_object(s));
+  EXPECT_NO_ALLOC(obj = mem.get_object("arr@first_element"));
+  EXPECT_NO_ALLOC(obj = mem.get_element(intern("arr"), intern("0")));
+  EXPECT_NO_ALLOC(obj = mem.get_array(intern("arr")));
+
+  // names which do not exist are not interned by lookups
+  EXPECT_NO_ALLOC(obj = mem.get_object("no_such_name"));
+  EXPECT_NO_ALLOC(obj = mem.get_object("arr@no_such_key"));
+
+  // accessors return references
+  obj = mem.get_object(s);
+  size_t length = 0;
+  EXPECT_NO_ALLOC(length += obj->get_value().size());
+  EXPECT_NO_ALLOC(length += obj->get_name().size());
+
+  // type names are built on first use, numbers are parsed once
+  ObjectTypeStr(OBJECT_NULL);
+  obj = mem.get_object("a_rather_long_variable_name");
+  obj->get_number();
+  EXPECT_NO_ALLOC(length += ObjectTypeStr(obj->get_type()).size());
+  EXPECT_NO_ALLOC(length += obj->get_number() > 100);
+
+  MemFunction f("f", nullptr, {"x", "y"});
+  EXPECT_NO_ALLOC(length += f.get_arg_names().size());
+
+  mem.exit_scope();
+  mem.exit_scope();
+  TEST_END();
+}
+
+int main() {
+  // All tests have _TEST keyword before initialization,
+  // they will be executed automatically
+  cout << "\n" << (failures ? "FAILED" : "PASSED") << "\n";
+  return failures ? 1 : 0;
+}
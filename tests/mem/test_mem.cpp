@@ -1,6 +1,8 @@
 #include <iostream>
+#include <sstream>
 
 #include "../../MemoryKernel.hpp"
+#include "../../diagnostics.hpp"
 
 using namespace std;
 
@@ -17,12 +19,16 @@ using namespace std;
 // print last n warning lines from warning file
 #define DUMP_WARN(n)                      \
   do {                                    \
+    Diagnostics::flush();                 \
     stringstream ss;                      \
     ss << "cat .nnl_warn | tail -n" << n; \
     std::system(ss.str().c_str());        \
   } while (0)
 
-_INIT void init_tests() { static std::ios_base::Init _; }
+_INIT void init_tests() {
+  static std::ios_base::Init _;
+  Diagnostics::configure(DIAG_FILE);  // warnings are off by default
+}
 
 /**************************************************
  *                  Tests Begin
@@ -298,17 +304,16 @@ _TEST void functions_intro() {
    * methods for function calls.
    */
 
-  AST::Block *b =
-      static_cast<AST::Block *>(malloc(1024));  // simulate some block of code
+  void *b = malloc(1024);  // simulate some block of code
 
   MemFunction *f = new MemFunction("some_func", b, vector<string>{"x", "y"});
 
   cout << "Function " << f->get_name() << " with " << f->count_args()
        << " parameters\n";
 
-  vector<string> args = f->get_arg_names();
+  const vector<Symbol> &args = f->get_arg_names();
   cout << "Following parameters are required: ";
-  for (string param : args) cout << param << " ";
+  for (Symbol param : args) cout << symbol_name(param) << " ";
   cout << "\n";
 
   // Functions are ordinal objects in memory
@@ -335,10 +340,9 @@ _TEST void function_prepare_memory_before_call() {
   MemoryKernel mem;
   mem.enter_scope();
 
-  AST::Block *b =
-      static_cast<AST::Block *>(malloc(1024));  // simulate some block of code
+  void *b = malloc(1024);  // simulate some block of code
   MemFunction *f = new MemFunction("some_func", b, vector<string>{"x", "y"});
-  vector<string> arg_names = f->get_arg_names();
+  const vector<Symbol> &arg_names = f->get_arg_names();
   vector<string> call_parameters = {
       "hello",  // this is for `x`
       "world"   // this is for `y`
@@ -383,8 +387,7 @@ _TEST void pass_array_to_function() {
    *
    */
 
-  AST::Block *b =
-      static_cast<AST::Block *>(malloc(1024));  // simulate some block of code
+  void *b = malloc(1024);  // simulate some block of code
   MemFunction *f = new MemFunction("some_func", b, vector<string>{"x", "y"});
   mem.put_object(f);
 
@@ -424,8 +427,7 @@ _TEST void function_wrong_number_of_arguments() {
    * be pushed to memory and `mem_prep` will return false
    */
 
-  AST::Block *b =
-      static_cast<AST::Block *>(malloc(1024));  // simulate some block of code
+  void *b = malloc(1024);  // simulate some block of code
   MemFunction *f = new MemFunction("some_func", b, vector<string>{"x", "y"});
   mem.put_object(f);
 
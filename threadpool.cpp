@@ -0,0 +1,102 @@
+#include "threadpool.hpp"
+
+#include <cstdlib>
+
+/**************************************************
+ *            ThreadPool Implementation
+ **************************************************/
+
+ThreadPool::ThreadPool(size_t size) : job(nullptr), generation(0), busy(0) {
+  for (size_t i = 0; i < size; ++i) queues.emplace_back(new Queue());
+  for (size_t i = 1; i < size; ++i)
+    threads.emplace_back(&ThreadPool::serve, this, i);
+}
+
+ThreadPool &ThreadPool::global() {
+  static ThreadPool *pool = [] {
+    size_t size = std::thread::hardware_concurrency();
+    if (const char *env = std::getenv("NNL_THREADS")) size = std::atol(env);
+    return new ThreadPool(size ? size : 1);
+  }();
+  return *pool;
+}
+
+size_t ThreadPool::size() const { return queues.size(); }
+
+bool ThreadPool::take(size_t worker, size_t &chunk) {
+  {
+    Queue &own = *queues[worker];
+    std::lock_guard<std::mutex> guard(own.lock);
+    if (!own.chunks.empty()) {
+      chunk = own.chunks.front();
+      own.chunks.pop_front();
+      return true;
+    }
+  }
+
+  // steal the farthest chunk of the next busy worker
+  for (size_t i = 1; i < queues.size(); ++i) {
+    Queue &other = *queues[(worker + i) % queues.size()];
+    std::lock_guard<std::mutex> guard(other.lock);
+    if (!other.chunks.empty()) {
+      chunk = other.chunks.back();
+      other.chunks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ThreadPool::work(size_t worker, const job_t &job) {
+  size_t chunk;
+  while (take(worker, chunk)) job(worker, chunk);
+}
+
+void ThreadPool::serve(size_t worker) {
+  unsigned long seen = 0;
+  std::unique_lock<std::mutex> guard(lock);
+
+  while (true) {
+    wake.wait(guard, [&] { return generation != seen; });
+    seen = generation;
+    const job_t *current = job;
+
+    guard.unlock();
+    work(worker, *current);
+    guard.lock();
+
+    if (--busy == 0) done.notify_one();
+  }
+}
+
+void ThreadPool::run(size_t chunks, const job_t &job) {
+  if (queues.size() == 1 || chunks < 2) {
+    for (size_t i = 0; i < chunks; ++i) job(0, i);
+    return;
+  }
+
+  // neighbouring chunks go to the same worker
+  size_t workers = queues.size();
+  for (size_t w = 0; w < workers; ++w) {
+    Queue &queue = *queues[w];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    for (size_t i = w * chunks / workers; i < (w + 1) * chunks / workers; ++i)
+      queue.chunks.push_back(i);
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    this->job = &job;
+    busy = threads.size();
+    ++generation;
+  }
+  wake.notify_all();
+
+  work(0, job);
+
+  // job may be used by pool threads until they leave it
+  std::unique_lock<std::mutex> guard(lock);
+  done.wait(guard, [this] { return busy == 0; });
+  this->job = nullptr;
+}
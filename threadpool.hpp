@@ -0,0 +1,80 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Work-stealing pool of threads for parallel builtins
+ *
+ * Job is split into chunks, each worker gets contiguous range
+ * of chunks in its own queue. Worker takes chunks from the front
+ * of its queue, when it is empty chunks are stolen from the back
+ * of other queues. Thread which runs the job is worker 0.
+ *
+ * Number of workers is taken from NNL_THREADS environment
+ * variable (number of hardware threads by default).
+ */
+class ThreadPool {
+ public:
+  // job receives index of worker and index of chunk
+  typedef std::function<void(size_t worker, size_t chunk)> job_t;
+
+ private:
+  struct Queue {
+    std::mutex lock;
+    std::deque<size_t> chunks;
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<std::unique_ptr<Queue>> queues;
+
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable done;
+
+  // current job, its number and number of threads still inside it
+  const job_t *job;
+  unsigned long generation;
+  size_t busy;
+
+  explicit ThreadPool(size_t size);
+
+  // take next chunk for worker (own or stolen)
+  bool take(size_t worker, size_t &chunk);
+
+  // run chunks of job until all queues are empty
+  void work(size_t worker, const job_t &job);
+
+  // loop of pool thread
+  void serve(size_t worker);
+
+ public:
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Pool shared by the whole interpreter (created on first use,
+   *        never destroyed, as program may exit from worker)
+   */
+  static ThreadPool &global();
+
+  // number of workers (including thread which runs the job)
+  size_t size() const;
+
+  /**
+   * @brief Run job for each chunk and wait until all chunks are done
+   *        (must not be called from a job)
+   *
+   * @param chunks Number of chunks
+   * @param job Called once for each chunk
+   */
+  void run(size_t chunks, const job_t &job);
+};
+
+#endif  // THREADPOOL_HPP
@@ -0,0 +1,331 @@
+#include "vecmath.hpp"
+
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VECMATH_X86
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+// implementation of all kernels for one instruction set
+struct Kernels {
+  const char *isa;
+  double (*sum)(const double *, size_t);
+  double (*min)(const double *, size_t);
+  double (*max)(const double *, size_t);
+  double (*dot)(const double *, const double *, size_t);
+  void (*scale)(const double *, double, double *, size_t);
+  void (*add)(const double *, const double *, double *, size_t);
+  void (*mul)(const double *, const double *, double *, size_t);
+};
+
+const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+
+/**************************************************
+ *                 Scalar Kernels
+ **************************************************/
+
+double sum_scalar(const double *x, size_t n) {
+  double s = 0;
+  for (size_t i = 0; i < n; ++i) s += x[i];
+  return s;
+}
+
+double min_scalar(const double *x, size_t n) {
+  double m = x[0];
+  for (size_t i = 0; i < n; ++i) {
+    if (x[i] != x[i]) return NOT_A_NUMBER;
+    m = x[i] < m ? x[i] : m;
+  }
+  return m;
+}
+
+double max_scalar(const double *x, size_t n) {
+  double m = x[0];
+  for (size_t i = 0; i < n; ++i) {
+    if (x[i] != x[i]) return NOT_A_NUMBER;
+    m = x[i] > m ? x[i] : m;
+  }
+  return m;
+}
+
+double dot_scalar(const double *x, const double *y, size_t n) {
+  double s = 0;
+  for (size_t i = 0; i < n; ++i) s += x[i] * y[i];
+  return s;
+}
+
+void scale_scalar(const double *x, double k, double *out, size_t n) {
+  for (size_t i = 0; i < n; ++i) out[i] = x[i] * k;
+}
+
+void add_scalar(const double *x, const double *y, double *out, size_t n) {
+  for (size_t i = 0; i < n; ++i) out[i] = x[i] + y[i];
+}
+
+void mul_scalar(const double *x, const double *y, double *out, size_t n) {
+  for (size_t i = 0; i < n; ++i) out[i] = x[i] * y[i];
+}
+
+const Kernels scalar = {"scalar",   sum_scalar, min_scalar, max_scalar,
+                        dot_scalar, scale_scalar, add_scalar, mul_scalar};
+
+#ifdef VECMATH_X86
+
+/**************************************************
+ *                  SSE2 Kernels
+ **************************************************/
+
+TARGET_SSE2 double hsum(__m128d v) {
+  return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+TARGET_SSE2 double sum_sse2(const double *x, size_t n) {
+  __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    a = _mm_add_pd(a, _mm_loadu_pd(x + i));
+    b = _mm_add_pd(b, _mm_loadu_pd(x + i + 2));
+  }
+  double s = hsum(_mm_add_pd(a, b));
+  for (; i < n; ++i) s += x[i];
+  return s;
+}
+
+// minpd/maxpd return the second operand when either is NaN, so
+// NaN lanes are collected separately (cmpunord) and win at the end
+
+TARGET_SSE2 double min_sse2(const double *x, size_t n) {
+  if (n < 2) return min_scalar(x, n);
+  __m128d m = _mm_loadu_pd(x);
+  __m128d nan = _mm_cmpunord_pd(m, m);
+  for (size_t i = 2; i + 2 <= n; i += 2) {
+    __m128d v = _mm_loadu_pd(x + i);
+    nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+    m = _mm_min_pd(m, v);
+  }
+  // last (overlapping) pair covers the tail
+  __m128d v = _mm_loadu_pd(x + n - 2);
+  nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+  m = _mm_min_pd(m, v);
+  if (_mm_movemask_pd(nan)) return NOT_A_NUMBER;
+  return _mm_cvtsd_f64(_mm_min_sd(m, _mm_unpackhi_pd(m, m)));
+}
+
+TARGET_SSE2 double max_sse2(const double *x, size_t n) {
+  if (n < 2) return max_scalar(x, n);
+  __m128d m = _mm_loadu_pd(x);
+  __m128d nan = _mm_cmpunord_pd(m, m);
+  for (size_t i = 2; i + 2 <= n; i += 2) {
+    __m128d v = _mm_loadu_pd(x + i);
+    nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+    m = _mm_max_pd(m, v);
+  }
+  // last (overlapping) pair covers the tail
+  __m128d v = _mm_loadu_pd(x + n - 2);
+  nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+  m = _mm_max_pd(m, v);
+  if (_mm_movemask_pd(nan)) return NOT_A_NUMBER;
+  return _mm_cvtsd_f64(_mm_max_sd(m, _mm_unpackhi_pd(m, m)));
+}
+
+TARGET_SSE2 double dot_sse2(const double *x, const double *y, size_t n) {
+  __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    a = _mm_add_pd(a, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+    b = _mm_add_pd(b, _mm_mul_pd(_mm_loadu_pd(x + i + 2),
+                                 _mm_loadu_pd(y + i + 2)));
+  }
+  double s = hsum(_mm_add_pd(a, b));
+  for (; i < n; ++i) s += x[i] * y[i];
+  return s;
+}
+
+TARGET_SSE2 void scale_sse2(const double *x, double k, double *out, size_t n) {
+  __m128d f = _mm_set1_pd(k);
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(x + i), f));
+  for (; i < n; ++i) out[i] = x[i] * k;
+}
+
+TARGET_SSE2 void add_sse2(const double *x, const double *y, double *out,
+                          size_t n) {
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(out + i,
+                  _mm_add_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+  for (; i < n; ++i) out[i] = x[i] + y[i];
+}
+
+TARGET_SSE2 void mul_sse2(const double *x, const double *y, double *out,
+                          size_t n) {
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2)
+    _mm_storeu_pd(out + i,
+                  _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+  for (; i < n; ++i) out[i] = x[i] * y[i];
+}
+
+const Kernels sse2 = {"sse2",   sum_sse2,   min_sse2, max_sse2,
+                      dot_sse2, scale_sse2, add_sse2, mul_sse2};
+
+/**************************************************
+ *                  AVX2 Kernels
+ **************************************************/
+
+TARGET_AVX2 double hsum(__m256d v) {
+  __m128d s =
+      _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+  return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+TARGET_AVX2 double sum_avx2(const double *x, size_t n) {
+  __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    a = _mm256_add_pd(a, _mm256_loadu_pd(x + i));
+    b = _mm256_add_pd(b, _mm256_loadu_pd(x + i + 4));
+  }
+  double s = hsum(_mm256_add_pd(a, b));
+  for (; i < n; ++i) s += x[i];
+  return s;
+}
+
+TARGET_AVX2 double min_avx2(const double *x, size_t n) {
+  if (n < 4) return min_scalar(x, n);
+  __m256d m = _mm256_loadu_pd(x);
+  __m256d nan = _mm256_cmp_pd(m, m, _CMP_UNORD_Q);
+  for (size_t i = 4; i + 4 <= n; i += 4) {
+    __m256d v = _mm256_loadu_pd(x + i);
+    nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    m = _mm256_min_pd(m, v);
+  }
+  // last (overlapping) block covers the tail
+  __m256d v = _mm256_loadu_pd(x + n - 4);
+  nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+  m = _mm256_min_pd(m, v);
+  if (_mm256_movemask_pd(nan)) return NOT_A_NUMBER;
+  __m128d h =
+      _mm_min_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+  return _mm_cvtsd_f64(_mm_min_sd(h, _mm_unpackhi_pd(h, h)));
+}
+
+TARGET_AVX2 double max_avx2(const double *x, size_t n) {
+  if (n < 4) return max_scalar(x, n);
+  __m256d m = _mm256_loadu_pd(x);
+  __m256d nan = _mm256_cmp_pd(m, m, _CMP_UNORD_Q);
+  for (size_t i = 4; i + 4 <= n; i += 4) {
+    __m256d v = _mm256_loadu_pd(x + i);
+    nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+    m = _mm256_max_pd(m, v);
+  }
+  __m256d v = _mm256_loadu_pd(x + n - 4);
+  nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+  m = _mm256_max_pd(m, v);
+  if (_mm256_movemask_pd(nan)) return NOT_A_NUMBER;
+  __m128d h =
+      _mm_max_pd(_mm256_castpd256_pd128(m), _mm256_extractf128_pd(m, 1));
+  return _mm_cvtsd_f64(_mm_max_sd(h, _mm_unpackhi_pd(h, h)));
+}
+
+TARGET_AVX2 double dot_avx2(const double *x, const double *y, size_t n) {
+  __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    a = _mm256_add_pd(a, _mm256_mul_pd(_mm256_loadu_pd(x + i),
+                                       _mm256_loadu_pd(y + i)));
+    b = _mm256_add_pd(b, _mm256_mul_pd(_mm256_loadu_pd(x + i + 4),
+                                       _mm256_loadu_pd(y + i + 4)));
+  }
+  double s = hsum(_mm256_add_pd(a, b));
+  for (; i < n; ++i) s += x[i] * y[i];
+  return s;
+}
+
+TARGET_AVX2 void scale_avx2(const double *x, double k, double *out, size_t n) {
+  __m256d f = _mm256_set1_pd(k);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(x + i), f));
+  for (; i < n; ++i) out[i] = x[i] * k;
+}
+
+TARGET_AVX2 void add_avx2(const double *x, const double *y, double *out,
+                          size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(x + i),
+                                            _mm256_loadu_pd(y + i)));
+  for (; i < n; ++i) out[i] = x[i] + y[i];
+}
+
+TARGET_AVX2 void mul_avx2(const double *x, const double *y, double *out,
+                          size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(x + i),
+                                            _mm256_loadu_pd(y + i)));
+  for (; i < n; ++i) out[i] = x[i] * y[i];
+}
+
+const Kernels avx2 = {"avx2",   sum_avx2,   min_avx2, max_avx2,
+                      dot_avx2, scale_avx2, add_avx2, mul_avx2};
+
+#endif  // VECMATH_X86
+
+// best implementation supported by CPU (and allowed by NNL_SIMD)
+const Kernels &select() {
+  const char *env = std::getenv("NNL_SIMD");
+  std::string limit = env ? env : "";
+  if (limit == "scalar") return scalar;
+
+#ifdef VECMATH_X86
+  __builtin_cpu_init();
+  if (limit != "sse2" && __builtin_cpu_supports("avx2")) return avx2;
+  if (__builtin_cpu_supports("sse2")) return sse2;
+#endif
+  return scalar;
+}
+
+const Kernels &kernels() {
+  static const Kernels &chosen = select();
+  return chosen;
+}
+
+}  // namespace
+
+/**************************************************
+ *             VecMath Implementation
+ **************************************************/
+
+double VecMath::sum(const double *x, size_t n) { return kernels().sum(x, n); }
+
+double VecMath::min(const double *x, size_t n) { return kernels().min(x, n); }
+
+double VecMath::max(const double *x, size_t n) { return kernels().max(x, n); }
+
+double VecMath::dot(const double *x, const double *y, size_t n) {
+  return kernels().dot(x, y, n);
+}
+
+void VecMath::scale(const double *x, double k, double *out, size_t n) {
+  kernels().scale(x, k, out, n);
+}
+
+void VecMath::add(const double *x, const double *y, double *out, size_t n) {
+  kernels().add(x, y, out, n);
+}
+
+void VecMath::mul(const double *x, const double *y, double *out, size_t n) {
+  kernels().mul(x, y, out, n);
+}
+
+const char *VecMath::isa() { return kernels().isa; }
@@ -0,0 +1,36 @@
+#ifndef VECMATH_HPP
+#define VECMATH_HPP
+
+#include <cstddef>
+
+/**
+ * @brief Numeric kernels over contiguous buffers of doubles
+ *        (typed arrays, see `ArrayData`)
+ *
+ * Implementation is selected once by CPU features: AVX2, SSE2
+ * or scalar loops. NNL_SIMD environment variable ("avx2", "sse2"
+ * or "scalar") limits selection, e.g. to check scalar fallback.
+ *
+ * Vector reductions add numbers in other order than scalar loop,
+ * so sums of fractions may differ in the last digits.
+ */
+class VecMath {
+ public:
+  static double sum(const double *x, size_t n);
+
+  // smallest and largest of `n` > 0 numbers, NaN if any of them is NaN
+  static double min(const double *x, size_t n);
+  static double max(const double *x, size_t n);
+
+  static double dot(const double *x, const double *y, size_t n);
+
+  // elementwise kernels, `out` may be one of inputs
+  static void scale(const double *x, double k, double *out, size_t n);
+  static void add(const double *x, const double *y, double *out, size_t n);
+  static void mul(const double *x, const double *y, double *out, size_t n);
+
+  // name of selected implementation
+  static const char *isa();
+};
+
+#endif  // VECMATH_HPP